@@ -0,0 +1,157 @@
+/* @file benchutil.h
+ * @brief The following code gives helpers shared by the benchmarks:
+ * generators for large graphs, a wall clock timer and a cache miss counter.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+
+#include "graph.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// @return zero padded label so label order matches the vertex number
+inline string benchLabel(int i) {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "v%07d", i);
+  return buf;
+}
+
+/* fill graph with vertices 0..n-1, each with degree edges of weight 1..100
+ * most edges go to nearby vertices, like links within one web site,
+ * the rest go anywhere in the graph
+ */
+inline void benchGraph(Graph &graph, int n, int degree, unsigned seed = 42) {
+  mt19937 rng(seed);
+  uniform_int_distribution<int> any(0, n - 1);
+  uniform_int_distribution<int> near(-64, 64);
+  uniform_int_distribution<int> weight(1, 100);
+  uniform_int_distribution<int> coin(0, 9);
+  for (int i = 0; i < n; i++) {
+    graph.add(benchLabel(i));
+  }
+  for (int i = 0; i < n; i++) {
+    for (int d = 0; d < degree; d++) {
+      int j = coin(rng) < 8 ? (i + near(rng) + n) % n : any(rng);
+      graph.connect(benchLabel(i), benchLabel(j), weight(rng));
+    }
+  }
+}
+
+/* fill graph with a side x side grid, each cell linked both ways to its
+ * right and lower neighbor with weight 1..100, plus a few long links;
+ * labels are shuffled so label order says nothing about the structure
+ */
+inline void benchGrid(Graph &graph, int side, unsigned seed = 42) {
+  mt19937 rng(seed);
+  int n = side * side;
+  vector<int> name(n);
+  for (int i = 0; i < n; i++) {
+    name[i] = i;
+  }
+  shuffle(name.begin(), name.end(), rng);
+  uniform_int_distribution<int> any(0, n - 1);
+  uniform_int_distribution<int> weight(1, 100);
+  for (int i = 0; i < n; i++) {
+    int right = i % side + 1 < side ? i + 1 : -1;
+    int down = i + side < n ? i + side : -1;
+    for (int j : {right, down, i % 100 == 0 ? any(rng) : -1}) {
+      if (j >= 0) {
+        int w = weight(rng);
+        graph.connect(benchLabel(name[i]), benchLabel(name[j]), w);
+        graph.connect(benchLabel(name[j]), benchLabel(name[i]), w);
+      }
+    }
+  }
+}
+
+// seconds since construction
+class BenchTimer {
+public:
+  BenchTimer() : start(chrono::steady_clock::now()) {}
+
+  double seconds() const {
+    return chrono::duration<double>(chrono::steady_clock::now() - start)
+        .count();
+  }
+
+private:
+  chrono::steady_clock::time_point start;
+};
+
+// counts last level cache misses of this process, where perf events work
+class CacheMissCounter {
+public:
+  CacheMissCounter() {
+#ifdef __linux__
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+
+  CacheMissCounter(const CacheMissCounter &other) = delete;
+
+  CacheMissCounter &operator=(const CacheMissCounter &other) = delete;
+
+  ~CacheMissCounter() {
+#ifdef __linux__
+    if (fd >= 0) {
+      close(fd);
+    }
+#endif
+  }
+
+  // @return false when the kernel or hardware do not allow counting
+  bool available() const { return fd >= 0; }
+
+  void start() {
+#ifdef __linux__
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  // @return misses since start, -1 if not available
+  long long stop() {
+    long long count = -1;
+#ifdef __linux__
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+        count = -1;
+      }
+    }
+#endif
+    return count;
+  }
+
+private:
+  int fd = -1;
+};
+
+#endif // BENCHUTIL_H
@@ -0,0 +1,63 @@
+/* @file compressbench.cpp
+ * @brief Compares the size and traversal speed of CompactGraph and
+ * CompressedGraph. Usage: bench.out [vertices] [degree]
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "benchutil.h"
+#include "compactgraph.h"
+#include "compressedgraph.h"
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+// global value so the visit function is not optimized away
+// NOLINTNEXTLINE
+long long visited = 0;
+
+void countVisit(const string & /*label*/) { visited++; }
+
+// time bfs from several sources and dijkstra from a few
+template <typename G> void traverse(const char *name, const G &graph, int n) {
+  const int sources = 20;
+  BenchTimer bfsTimer;
+  for (int s = 0; s < sources; s++) {
+    graph.bfs(benchLabel(s * (n / sources)), countVisit);
+  }
+  double bfsSeconds = bfsTimer.seconds() / sources;
+
+  BenchTimer dijkstraTimer;
+  for (int s = 0; s < sources / 4; s++) {
+    graph.dijkstra(benchLabel(s * (n / sources)));
+  }
+  double dijkstraSeconds = dijkstraTimer.seconds() / (sources / 4);
+
+  MemoryUsage usage = graph.memoryUsage();
+  double bitsPerEdge = 8.0 * (usage.edges + usage.vertices) /
+                       (static_cast<double>(graph.edgesSize()));
+  cout << name << ": adjacency " << usage.edges + usage.vertices
+       << " bytes, " << bitsPerEdge << " bits/edge, bfs "
+       << bfsSeconds * 1000 << " ms, dijkstra " << dijkstraSeconds * 1000
+       << " ms" << endl;
+}
+
+int main(int argc, char *argv[]) {
+  int n = argc > 1 ? atoi(argv[1]) : 5000;
+  int degree = argc > 2 ? atoi(argv[2]) : 16;
+
+  Graph graph;
+  BenchTimer buildTimer;
+  benchGraph(graph, n, degree);
+  cout << "graph: " << graph.verticesSize() << " vertices, "
+       << graph.edgesSize() << " edges, built in " << buildTimer.seconds()
+       << " s" << endl;
+
+  CompactGraph compact(graph);
+  CompressedGraph compressed(compact);
+  cout << "weight width: " << compressed.weightWidth() << " bytes" << endl;
+  traverse("compact   ", compact, n);
+  traverse("compressed", compressed, n);
+  return visited > 0 ? 0 : 1;
+}
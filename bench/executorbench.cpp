@@ -0,0 +1,111 @@
+/* @file executorbench.cpp
+ * @brief Load generator for QueryExecutor: keeps a number of batches of
+ * mixed dijkstra, bfs and edge queries in flight and reports throughput
+ * and p50/p99 latency, next to the same queries run one at a time on a
+ * CompactGraph. Sources cluster around a few hot vertices per batch, like
+ * requests for one region of a map.
+ * Usage: bench.out [vertices] [threads] [batches] [batchSize]
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "benchutil.h"
+#include "compactgraph.h"
+#include "queryexecutor.h"
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+// latency at fraction p of sorted latencies, in milliseconds
+double percentile(const vector<double> &sorted, double p) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  return sorted[static_cast<size_t>(p * (sorted.size() - 1))] * 1000;
+}
+
+void report(const char *name, vector<double> &latencies, double seconds) {
+  sort(latencies.begin(), latencies.end());
+  cout << name << ": " << latencies.size() / seconds << " queries/s, p50 "
+       << percentile(latencies, 0.5) << " ms, p99 "
+       << percentile(latencies, 0.99) << " ms" << endl;
+}
+
+int main(int argc, char *argv[]) {
+  int n = argc > 1 ? atoi(argv[1]) : 20000;
+  int threads = argc > 2 ? atoi(argv[2]) : 0;
+  int batchCount = argc > 3 ? atoi(argv[3]) : 16;
+  int batchSize = argc > 4 ? atoi(argv[4]) : 64;
+
+  Graph graph;
+  BenchTimer buildTimer;
+  benchGraph(graph, n, 8);
+  cout << "graph: " << graph.verticesSize() << " vertices, "
+       << graph.edgesSize() << " edges, built in " << buildTimer.seconds()
+       << " s" << endl;
+
+  mt19937 rng(42);
+  uniform_int_distribution<int> any(0, n - 1);
+  uniform_int_distribution<int> near(-16, 16);
+  uniform_int_distribution<int> kind(0, 9);
+  vector<vector<Query>> batches(batchCount);
+  for (auto &batch : batches) {
+    int centers[4] = {any(rng), any(rng), any(rng), any(rng)};
+    for (int i = 0; i < batchSize; i++) {
+      Query query;
+      int k = kind(rng);
+      query.kind = k < 2 ? kQueryDijkstra : k < 4 ? kQueryBfs : kQueryEdges;
+      query.label = benchLabel((centers[i % 4] + near(rng) + n) % n);
+      batch.push_back(query);
+    }
+  }
+
+  // one query at a time, latency is the query itself
+  CompactGraph compact(graph);
+  vector<double> single;
+  BenchTimer singleTimer;
+  long long checksum = 0;
+  for (auto &batch : batches) {
+    for (auto &query : batch) {
+      BenchTimer timer;
+      if (query.kind == kQueryDijkstra) {
+        checksum += compact.dijkstra(query.label).first.size();
+      } else if (query.kind == kQueryBfs) {
+        compact.bfs(query.label, [](const string & /*label*/) {});
+      } else {
+        checksum += compact.getEdgesAsString(query.label).size();
+      }
+      single.push_back(timer.seconds());
+    }
+  }
+  report("single  ", single, singleTimer.seconds());
+
+  // inFlight batches submitted together, latency includes the time queued
+  for (int inFlight : {1, 4, batchCount}) {
+    QueryExecutor executor(graph, threads);
+    vector<double> latencies;
+    BenchTimer timer;
+    for (size_t next = 0; next < batches.size();) {
+      size_t end = min(batches.size(), next + inFlight);
+      vector<future<vector<QueryResult>>> pending;
+      for (; next < end; next++) {
+        pending.push_back(executor.submit(batches[next]));
+      }
+      for (auto &f : pending) {
+        for (auto &result : f.get()) {
+          checksum += result.paths.first.size();
+          latencies.push_back(result.latency);
+        }
+      }
+    }
+    double seconds = timer.seconds();
+    ExecutorStats stats = executor.stats();
+    cout << "executor, " << executor.threads() << " threads, " << inFlight
+         << " batches in flight, " << stats.computed << " of "
+         << stats.queries << " computed, " << stats.steals << " steals"
+         << endl;
+    report("executor", latencies, seconds);
+  }
+  return checksum > 0 ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+/* @file reorderbench.cpp
+ * @brief Compares bfs and dijkstra on a CompactGraph under each vertex
+ * numbering, for a grid whose labels are shuffled so the initial label
+ * order is effectively random. Usage: bench.out [side]
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "benchutil.h"
+#include "compactgraph.h"
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+// global value so the visit function is not optimized away
+// NOLINTNEXTLINE
+long long visited = 0;
+
+void countVisit(const string & /*label*/) { visited++; }
+
+int main(int argc, char *argv[]) {
+  int side = argc > 1 ? atoi(argv[1]) : 400;
+
+  Graph graph;
+  BenchTimer buildTimer;
+  benchGrid(graph, side);
+  cout << "grid: " << graph.verticesSize() << " vertices, "
+       << graph.edgesSize() << " edges, built in " << buildTimer.seconds()
+       << " s" << endl;
+
+  CompactGraph compact(graph);
+  CacheMissCounter misses;
+  if (!misses.available()) {
+    cout << "cache miss counter not available, misses shown as -1" << endl;
+  }
+  const int sources = 4;
+  const char *names[] = {"label ", "degree", "bfs   ", "rcm   "};
+  for (VertexOrder order : {kOrderLabel, kOrderDegree, kOrderBfs, kOrderRcm}) {
+    BenchTimer reorderTimer;
+    compact.reorder(order);
+    double reorderSeconds = reorderTimer.seconds();
+
+    misses.start();
+    BenchTimer bfsTimer;
+    for (int s = 0; s < sources; s++) {
+      compact.bfs(benchLabel(s * 997), countVisit);
+    }
+    double bfsSeconds = bfsTimer.seconds() / sources;
+    long long bfsMisses = misses.stop();
+
+    misses.start();
+    BenchTimer dijkstraTimer;
+    for (int s = 0; s < sources; s++) {
+      compact.dijkstra(benchLabel(s * 997));
+    }
+    double dijkstraSeconds = dijkstraTimer.seconds() / sources;
+    long long dijkstraMisses = misses.stop();
+
+    cout << names[order] << ": reorder " << reorderSeconds * 1000
+         << " ms, bfs " << bfsSeconds * 1000 << " ms ("
+         << (bfsMisses < 0 ? -1 : bfsMisses / sources) << " misses), dijkstra "
+         << dijkstraSeconds * 1000 << " ms ("
+         << (dijkstraMisses < 0 ? -1 : dijkstraMisses / sources)
+         << " misses)" << endl;
+  }
+  return visited > 0 ? 0 : 1;
+}
@@ -0,0 +1,19 @@
+#!/bin/bash
+
+# Build and run every benchmark in bench/ with optimizations
+# Run this script from the top directory as `./bench/run-bench.sh`
+# Extra arguments are passed on to each benchmark
+
+# every source file except the test driver
+SOURCES=`ls *.cpp | grep -v -e '^main.cpp$' -e '^graphtest.cpp$'`
+
+for bench in bench/*.cpp; do
+  echo "====================================================="
+  echo "$bench"
+  echo "====================================================="
+  rm ./bench.out 2>/dev/null
+  g++ -O2 -std=c++11 -pthread -I. $SOURCES $bench -o bench.out
+  ./bench.out "$@"
+done
+
+rm ./bench.out 2>/dev/null
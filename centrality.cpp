@@ -0,0 +1,266 @@
+/* @file centrality.cpp
+ * @brief The following code gives the implementations of the centrality
+ * analytics.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "centrality.h"
+#include "compactgraph.h"
+#include "parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <random>
+
+using namespace std;
+
+/* constructor copies the adjacency of graph in breadth-first order, so the
+ * in-neighbors PageRank reads for a vertex have nearby ids, and builds the
+ * reversed adjacency with a counting sort
+ * @param graph is the graph being analyzed, threads is the thread count
+ */
+CentralityAnalytics::CentralityAnalytics(const Graph &graph, int threads)
+    : threads(threadCount(threads)) {
+  CompactGraph compact(graph);
+  compact.reorder(kOrderBfs);
+  directed = compact.directionalEdges;
+  labels = compact.labels;
+  offsets = compact.offsets;
+  targets = compact.targets;
+
+  uint32_t n = verticesSize();
+  inOffsets.assign(n + 1, 0);
+  for (auto &t : targets) {
+    inOffsets[t + 1]++;
+  }
+  for (uint32_t v = 0; v < n; v++) {
+    inOffsets[v + 1] += inOffsets[v];
+  }
+  // sources are visited in increasing order, so every in-list is sorted
+  sources.resize(targets.size());
+  vector<uint64_t> fill(inOffsets.begin(), inOffsets.end() - 1);
+  for (uint32_t v = 0; v < n; v++) {
+    for (uint64_t i = offsets[v]; i < offsets[v + 1]; i++) {
+      sources[fill[targets[i]]++] = v;
+    }
+  }
+}
+
+// verticesSize returns the number of vertices
+uint32_t CentralityAnalytics::verticesSize() const {
+  return offsets.size() - 1;
+}
+
+// inDegree returns the number of edges into label, -1 if not found
+int CentralityAnalytics::inDegree(const string &label) const {
+  uint32_t v = 0;
+  if (!labels.find(label, v)) {
+    return -1;
+  }
+  return inOffsets[v + 1] - inOffsets[v];
+}
+
+// outDegree returns the number of edges from label, -1 if not found
+int CentralityAnalytics::outDegree(const string &label) const {
+  uint32_t v = 0;
+  if (!labels.find(label, v)) {
+    return -1;
+  }
+  return offsets[v + 1] - offsets[v];
+}
+
+// inDegrees returns the in-degree of every vertex
+map<string, int> CentralityAnalytics::inDegrees() const {
+  map<string, int> result;
+  for (uint32_t k = 0; k < verticesSize(); k++) {
+    uint32_t v = labels.byLabel(k);
+    result.emplace_hint(result.end(), labels.label(v),
+                        inOffsets[v + 1] - inOffsets[v]);
+  }
+  return result;
+}
+
+// outDegrees returns the out-degree of every vertex
+map<string, int> CentralityAnalytics::outDegrees() const {
+  map<string, int> result;
+  for (uint32_t k = 0; k < verticesSize(); k++) {
+    uint32_t v = labels.byLabel(k);
+    result.emplace_hint(result.end(), labels.label(v),
+                        offsets[v + 1] - offsets[v]);
+  }
+  return result;
+}
+
+// pageRank jumps to every vertex with the same probability
+PageRankResult
+CentralityAnalytics::pageRank(const PageRankOptions &options) const {
+  uint32_t n = verticesSize();
+  if (n == 0) {
+    return PageRankResult();
+  }
+  return run(vector<double>(n, 1.0 / n), options);
+}
+
+// personalizedPageRank jumps only to the given sources
+PageRankResult CentralityAnalytics::personalizedPageRank(
+    const vector<string> &sources, const PageRankOptions &options) const {
+  vector<double> jump(verticesSize(), 0);
+  double count = 0;
+  for (auto &label : sources) {
+    uint32_t v = 0;
+    if (labels.find(label, v) && jump[v] == 0) {
+      jump[v] = 1;
+      count++;
+    }
+  }
+  if (count == 0) {
+    return PageRankResult();
+  }
+  for (auto &j : jump) {
+    j /= count;
+  }
+  return run(jump, options);
+}
+
+/* run is the power iteration shared by both PageRank variants, rank that
+ * would leave a vertex without edges is handed out like a jump
+ * @param jump is the jump probability of each vertex, options the limits
+ */
+PageRankResult CentralityAnalytics::run(const vector<double> &jump,
+                                        const PageRankOptions &options) const {
+  uint32_t n = verticesSize();
+  vector<double> rank(jump);
+  vector<double> next(n);
+  vector<double> share(n);
+  PageRankResult result;
+  mutex lock;
+  for (result.iterations = 0; result.iterations < options.maxIterations;) {
+    result.iterations++;
+    double dangling = 0;
+    for (uint32_t v = 0; v < n; v++) {
+      uint32_t degree = offsets[v + 1] - offsets[v];
+      if (degree == 0) {
+        dangling += rank[v];
+        share[v] = 0;
+      } else {
+        share[v] = rank[v] / degree;
+      }
+    }
+    double delta = 0;
+    parallelFor(n, threads, [&](size_t begin, size_t end) {
+      double localDelta = 0;
+      for (size_t v = begin; v < end; v++) {
+        double sum = 0;
+        for (uint64_t i = inOffsets[v]; i < inOffsets[v + 1]; i++) {
+          sum += share[sources[i]];
+        }
+        next[v] = (1 - options.damping) * jump[v] +
+                  options.damping * (sum + dangling * jump[v]);
+        localDelta += fabs(next[v] - rank[v]);
+      }
+      lock_guard<mutex> guard(lock);
+      delta += localDelta;
+    }, 1024);
+    rank.swap(next);
+    result.delta = delta;
+    if (delta < options.tolerance) {
+      break;
+    }
+  }
+  // ids are not in label order, so walk the labels to append to the map
+  for (uint32_t k = 0; k < n; k++) {
+    uint32_t v = labels.byLabel(k);
+    result.ranks.emplace_hint(result.ranks.end(), labels.label(v), rank[v]);
+  }
+  return result;
+}
+
+/* betweenness runs a BFS from each chosen source and accumulates the
+ * dependencies back up the BFS order; each thread allocates its state once,
+ * takes sources from a shared counter and adds its totals in at the end
+ * @param samples is the number of random sources, seed picks them
+ */
+map<string, double> CentralityAnalytics::betweenness(int samples,
+                                                     unsigned seed) const {
+  uint32_t n = verticesSize();
+  // sampled by label rank, so a seed picks the same sources in any order
+  vector<uint32_t> chosen(n);
+  for (uint32_t k = 0; k < n; k++) {
+    chosen[k] = labels.byLabel(k);
+  }
+  double scale = 1;
+  if (samples > 0 && static_cast<uint32_t>(samples) < n) {
+    mt19937 rng(seed);
+    shuffle(chosen.begin(), chosen.end(), rng);
+    chosen.resize(samples);
+    scale = static_cast<double>(n) / samples;
+  }
+  if (!directed) {
+    scale /= 2;
+  }
+
+  vector<double> total(n, 0);
+  mutex lock;
+  atomic<size_t> next(0);
+  size_t workers = min<size_t>(threads, chosen.size());
+  parallelFor(workers, static_cast<int>(workers), [&](size_t, size_t) {
+    vector<double> local(n, 0);
+    vector<double> paths(n);
+    vector<double> dependency(n);
+    vector<int> dist(n, -1);
+    vector<uint32_t> order;
+    order.reserve(n);
+    for (size_t c = next++; c < chosen.size(); c = next++) {
+      uint32_t s = chosen[c];
+      for (auto &v : order) {
+        dist[v] = -1;
+      }
+      order.clear();
+      dist[s] = 0;
+      paths[s] = 1;
+      order.push_back(s);
+      for (size_t head = 0; head < order.size(); head++) {
+        uint32_t v = order[head];
+        for (uint64_t i = offsets[v]; i < offsets[v + 1]; i++) {
+          uint32_t w = targets[i];
+          if (dist[w] < 0) {
+            dist[w] = dist[v] + 1;
+            paths[w] = 0;
+            order.push_back(w);
+          }
+          if (dist[w] == dist[v] + 1) {
+            paths[w] += paths[v];
+          }
+        }
+      }
+      for (auto &v : order) {
+        dependency[v] = 0;
+      }
+      for (size_t k = order.size(); k-- > 0;) {
+        uint32_t v = order[k];
+        for (uint64_t i = offsets[v]; i < offsets[v + 1]; i++) {
+          uint32_t w = targets[i];
+          if (dist[w] == dist[v] + 1) {
+            dependency[v] += paths[v] / paths[w] * (1 + dependency[w]);
+          }
+        }
+        if (v != s) {
+          local[v] += dependency[v];
+        }
+      }
+    }
+    lock_guard<mutex> guard(lock);
+    for (uint32_t v = 0; v < n; v++) {
+      total[v] += local[v];
+    }
+  }, 1);
+
+  map<string, double> result;
+  for (uint32_t k = 0; k < n; k++) {
+    uint32_t v = labels.byLabel(k);
+    result.emplace_hint(result.end(), labels.label(v), total[v] * scale);
+  }
+  return result;
+}
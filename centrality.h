@@ -0,0 +1,116 @@
+/* @file centrality.h
+ * @brief The following code gives the declarations of the centrality
+ * analytics: in and out degrees, PageRank, personalized PageRank and
+ * (sampled) betweenness centrality. PageRank pulls ranks over the reversed
+ * adjacency, so every vertex is written by exactly one thread and the
+ * sources of each vertex are read in increasing id order.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#ifndef CENTRALITY_H
+#define CENTRALITY_H
+
+#include "labelpool.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class Graph;
+
+// settings for pageRank and personalizedPageRank
+struct PageRankOptions {
+  // probability of following an edge instead of jumping
+  double damping = 0.85;
+
+  // stop when the sum of rank changes in one iteration is below tolerance
+  double tolerance = 1e-9;
+
+  // stop after this many iterations even if not converged
+  int maxIterations = 100;
+};
+
+// ranks, summing to 1, and how they were reached
+struct PageRankResult {
+  map<string, double> ranks;
+
+  int iterations = 0;
+
+  // sum of rank changes in the last iteration
+  double delta = 0;
+};
+
+class CentralityAnalytics {
+public:
+  // snapshot of graph, work is split across threads threads
+  // threads <= 0 uses every hardware thread
+  explicit CentralityAnalytics(const Graph &graph, int threads = 0);
+
+  // copy not allowed
+  CentralityAnalytics(const CentralityAnalytics &other) = delete;
+
+  // move not allowed
+  CentralityAnalytics(CentralityAnalytics &&other) = delete;
+
+  // assignment not allowed
+  CentralityAnalytics &operator=(const CentralityAnalytics &other) = delete;
+
+  // move assignment not allowed
+  CentralityAnalytics &operator=(CentralityAnalytics &&other) = delete;
+
+  ~CentralityAnalytics() = default;
+
+  // @return number of edges into label, -1 if vertex not found
+  int inDegree(const string &label) const;
+
+  // @return number of edges from label, -1 if vertex not found
+  int outDegree(const string &label) const;
+
+  // @return in-degree of every vertex
+  map<string, int> inDegrees() const;
+
+  // @return out-degree of every vertex
+  map<string, int> outDegrees() const;
+
+  // PageRank with jumps to any vertex
+  PageRankResult pageRank(const PageRankOptions &options = PageRankOptions()) const;
+
+  // PageRank with jumps only to sources, unknown labels are ignored
+  // @return empty ranks if no source is in the graph
+  PageRankResult
+  personalizedPageRank(const vector<string> &sources,
+                       const PageRankOptions &options = PageRankOptions()) const;
+
+  // betweenness using unweighted shortest paths (Brandes)
+  // samples > 0 runs from that many random sources and scales the result,
+  // samples <= 0 or >= verticesSize runs from every vertex, exact
+  // undirected graphs count each pair of vertices once
+  map<string, double> betweenness(int samples = 0, unsigned seed = 1) const;
+
+private:
+  int threads;
+
+  bool directed;
+
+  LabelPool labels;
+
+  // out-neighbors of v are targets[offsets[v]] .. targets[offsets[v + 1] - 1]
+  vector<uint64_t> offsets;
+
+  vector<uint32_t> targets;
+
+  // in-neighbors of v are sources[inOffsets[v]] .. sources[inOffsets[v + 1] - 1]
+  vector<uint64_t> inOffsets;
+
+  vector<uint32_t> sources;
+
+  PageRankResult run(const vector<double> &jump,
+                     const PageRankOptions &options) const;
+
+  uint32_t verticesSize() const;
+};
+
+#endif // CENTRALITY_H
@@ -24,7 +24,7 @@ for p in "${programs[@]}"; do
     fi
 done
 
-$CC -g -std=c++11 -fprofile-instr-generate -fcoverage-mapping *.cpp -o $EXE
+$CC -g -std=c++11 -pthread -fprofile-instr-generate -fcoverage-mapping *.cpp -o $EXE
 
 if [ ! -f $EXE ]; then
     echo "ERROR: $PROG: Failed to create executable"
@@ -0,0 +1,562 @@
+/* @file compactgraph.cpp
+ * @brief The following code gives the implementations of the compact,
+ * read-only graph.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "compactgraph.h"
+#include "graph.h"
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+
+using namespace std;
+
+namespace {
+
+// one stored edge while an edge list is read
+struct Arc {
+  uint32_t from;
+  uint32_t to;
+  int32_t weight;
+};
+
+} // namespace
+
+/* constructor copies graph into the compact layout, vertex ids follow label
+ * order so every adjacency list, already sorted by label, is also sorted by id
+ * @param graph is the graph being copied
+ */
+CompactGraph::CompactGraph(const Graph &graph) {
+  directionalEdges = graph.directionalEdges;
+  numberOfEdges = graph.numberOfEdges;
+
+  vector<Vertex *> sorted(graph.vertices);
+  sort(sorted.begin(), sorted.end(), [](const Vertex *a, const Vertex *b) {
+    return a->label < b->label;
+  });
+
+  unordered_map<const Vertex *, uint32_t> ids;
+  ids.reserve(sorted.size());
+  size_t poolSize = 0;
+  size_t edgeCount = 0;
+  for (uint32_t i = 0; i < sorted.size(); i++) {
+    ids.emplace(sorted[i], i);
+    poolSize += sorted[i]->label.size();
+    edgeCount += sorted[i]->neighbors.size();
+  }
+
+  labels.reserve(sorted.size(), poolSize);
+  offsets.reserve(sorted.size() + 1);
+  targets.reserve(edgeCount);
+  weights.reserve(edgeCount);
+
+  for (auto &v : sorted) {
+    labels.add(v->label);
+    offsets.push_back(targets.size());
+    for (auto &e : v->neighbors) {
+      targets.push_back(ids[e->to]);
+      weights.push_back(e->weight);
+    }
+  }
+  offsets.push_back(targets.size());
+}
+
+/* constructor reads every edge into a flat list with vertex ids in order
+ * of appearance, renumbers the vertices in label order and sorts the list
+ * into rows; like Graph::connect, self loops are skipped and of repeated
+ * edges the first one is kept
+ * @param reader is the edge list, result receives the outcome
+ */
+CompactGraph::CompactGraph(EdgeReader &reader, ReadResult &result,
+                           bool directionalEdges, const ReadOptions &options)
+    : directionalEdges(directionalEdges), numberOfEdges(0) {
+  unordered_map<string, uint32_t> ids;
+  // label of each id, pointing at the keys of ids
+  vector<const string *> names;
+  vector<Arc> arcs;
+  // verticesSize is an int, edges that would add a vertex past that fail
+  bool full = false;
+  auto idOf = [&ids, &names](const string &label) {
+    auto it = ids.emplace(label, static_cast<uint32_t>(names.size()));
+    if (it.second) {
+      names.push_back(&it.first->first);
+    }
+    return it.first->second;
+  };
+  result = readEdgeList(
+      reader, options,
+      [&](vector<EdgeRecord> &batch, ReadResult & /*result*/) {
+        for (auto &record : batch) {
+          if (record.from == record.to) {
+            continue;
+          }
+          if (names.size() + 2 > static_cast<size_t>(INT_MAX) &&
+              (ids.count(record.from) == 0 || ids.count(record.to) == 0)) {
+            full = true;
+            continue;
+          }
+          uint32_t from = idOf(record.from);
+          uint32_t to = idOf(record.to);
+          arcs.push_back(Arc{from, to, record.weight});
+          if (!this->directionalEdges) {
+            arcs.push_back(Arc{to, from, record.weight});
+          }
+        }
+        batch.clear();
+      });
+  if (full && result.ok) {
+    result.ok = false;
+    result.error = "more than " + to_string(INT_MAX) + " vertices";
+  }
+
+  uint32_t n = names.size();
+  vector<uint32_t> byLabel(n);
+  iota(byLabel.begin(), byLabel.end(), 0);
+  sort(byLabel.begin(), byLabel.end(), [&names](uint32_t a, uint32_t b) {
+    return *names[a] < *names[b];
+  });
+  size_t poolSize = 0;
+  for (auto &name : names) {
+    poolSize += name->size();
+  }
+  labels.reserve(n, poolSize);
+  vector<uint32_t> rank(n);
+  for (uint32_t k = 0; k < n; k++) {
+    labels.add(*names[byLabel[k]]);
+    rank[byLabel[k]] = k;
+  }
+  unordered_map<string, uint32_t>().swap(ids);
+  vector<const string *>().swap(names);
+  vector<uint32_t>().swap(byLabel);
+
+  for (auto &arc : arcs) {
+    arc.from = rank[arc.from];
+    arc.to = rank[arc.to];
+  }
+  vector<uint32_t>().swap(rank);
+  // stable, so the first of repeated edges comes first
+  stable_sort(arcs.begin(), arcs.end(), [](const Arc &a, const Arc &b) {
+    return a.from != b.from ? a.from < b.from : a.to < b.to;
+  });
+
+  offsets.reserve(n + 1);
+  targets.reserve(arcs.size());
+  weights.reserve(arcs.size());
+  size_t a = 0;
+  for (uint32_t v = 0; v < n; v++) {
+    offsets.push_back(targets.size());
+    for (; a < arcs.size() && arcs[a].from == v; a++) {
+      if (targets.size() > offsets.back() && targets.back() == arcs[a].to) {
+        continue;
+      }
+      targets.push_back(arcs[a].to);
+      weights.push_back(arcs[a].weight);
+    }
+  }
+  offsets.push_back(targets.size());
+  targets.shrink_to_fit();
+  weights.shrink_to_fit();
+  numberOfEdges = directionalEdges ? targets.size() : targets.size() / 2;
+  result.edgesAdded = numberOfEdges;
+}
+
+// verticesSize returns the total number of vertices
+int CompactGraph::verticesSize() const {
+  return static_cast<int>(offsets.size()) - 1;
+}
+
+// edgesSize returns the total number of edges
+long long CompactGraph::edgesSize() const { return numberOfEdges; }
+
+// contains checks if a vertex is in the graph
+bool CompactGraph::contains(const string &label) const {
+  uint32_t id = 0;
+  return labels.find(label, id);
+}
+
+// vertexDegree returns the number of edges from given vertex, -1 if not found
+int CompactGraph::vertexDegree(const string &label) const {
+  uint32_t id = 0;
+  if (!labels.find(label, id)) {
+    return -1;
+  }
+  return offsets[id + 1] - offsets[id];
+}
+
+/* getEdgesAsString creates a string of edges and weights
+ * A-3->B, A-5->C should return B(3),C(5)
+ * @param label is the string referenced
+ */
+string CompactGraph::getEdgesAsString(const string &label) const {
+  string s;
+  uint32_t id = 0;
+  if (!labels.find(label, id)) {
+    return s;
+  }
+  for (uint64_t i = offsets[id]; i < offsets[id + 1]; i++) {
+    if (i != offsets[id]) {
+      s += ",";
+    }
+    s += labels.label(targets[i]) + "(" + to_string(weights[i]) + ")";
+  }
+  return s;
+}
+
+/* dfs visits vertices in the same order as the recursive Graph::dfs,
+ * using an explicit stack of (vertex, next edge) so deep graphs do not
+ * overflow the call stack
+ * @param startLabel is where the traversal starts and calls visit
+ */
+void CompactGraph::dfs(const string &startLabel,
+                       void visit(const string &label)) const {
+  uint32_t start = 0;
+  if (!labels.find(startLabel, start)) {
+    return;
+  }
+  vector<char> visited(verticesSize(), 0);
+  vector<pair<uint32_t, uint64_t>> stack;
+  visited[start] = 1;
+  visit(labels.label(start));
+  stack.emplace_back(start, offsets[start]);
+  while (!stack.empty()) {
+    uint32_t v = stack.back().first;
+    uint64_t &next = stack.back().second;
+    if (next == offsets[v + 1]) {
+      stack.pop_back();
+      continue;
+    }
+    uint32_t n = targets[next++];
+    if (!visited[n]) {
+      visited[n] = 1;
+      visit(labels.label(n));
+      stack.emplace_back(n, offsets[n]);
+    }
+  }
+}
+
+/* bfs is the implementation of a breadth first search
+ * @param startLabel is where the traversal starts and calls visit
+ */
+void CompactGraph::bfs(const string &startLabel,
+                       void visit(const string &label)) const {
+  uint32_t start = 0;
+  if (!labels.find(startLabel, start)) {
+    return;
+  }
+  vector<char> visited(verticesSize(), 0);
+  vector<uint32_t> q;
+  q.reserve(verticesSize());
+  visited[start] = 1;
+  q.push_back(start);
+  for (size_t head = 0; head < q.size(); head++) {
+    uint32_t v = q[head];
+    visit(labels.label(v));
+    for (uint64_t i = offsets[v]; i < offsets[v + 1]; i++) {
+      uint32_t n = targets[i];
+      if (!visited[n]) {
+        visited[n] = 1;
+        q.push_back(n);
+      }
+    }
+  }
+}
+
+/* dijkstra runs with the scratch of this graph, so repeated queries neither
+ * allocate nor clear O(V) arrays; a thread that finds it in use by another
+ * search gets a scratch of its own for this call
+ * @param startLabel is where the search starts
+ */
+pair<map<string, int>, map<string, string>>
+CompactGraph::dijkstra(const string &startLabel) const {
+  unique_lock<mutex> guard(scratchLock, try_to_lock);
+  if (guard.owns_lock()) {
+    return dijkstra(startLabel, scratch);
+  }
+  SearchScratch local;
+  return dijkstra(startLabel, local);
+}
+
+/* dijkstra finds the shortest distance and previous vertex for every vertex
+ * reachable from startLabel, the start vertex itself is not reported
+ * @param startLabel is where the search starts, scratch the state to use
+ */
+pair<map<string, int>, map<string, string>>
+CompactGraph::dijkstra(const string &startLabel, SearchScratch &scratch) const {
+  // filled in place and returned as is, so the maps are never copied
+  pair<map<string, int>, map<string, string>> result;
+  auto &weightsMap = result.first;
+  auto &previous = result.second;
+  uint32_t start = 0;
+  if (!labels.find(startLabel, start)) {
+    return result;
+  }
+
+  scratch.begin(verticesSize(), targets.size());
+  search(start, scratch, -1);
+  // list the label ranks of the settled vertices in order, so every insert
+  // goes at the end: a few are sorted, many are found by walking the labels
+  auto &settled = scratch.order;
+  if (settled.size() < verticesSize() / 16) {
+    for (auto &v : settled) {
+      v = labels.rank(v);
+    }
+    sort(settled.begin(), settled.end());
+  } else {
+    settled.clear();
+    for (uint32_t k = 0; k < scratch.done.size(); k++) {
+      if (scratch.settled(labels.byLabel(k))) {
+        settled.push_back(k);
+      }
+    }
+  }
+  for (auto &k : settled) {
+    uint32_t v = labels.byLabel(k);
+    if (v != start) {
+      string name = labels.label(v);
+      weightsMap.emplace_hint(weightsMap.end(), name, scratch.dist[v]);
+      previous.emplace_hint(previous.end(), name,
+                            labels.label(scratch.prev[v]));
+    }
+  }
+  return result;
+}
+
+/* search is the heap-based Dijkstra shared by dijkstra and PathFinder, it
+ * stops when the heap is empty, when every marked target is settled or
+ * when the next vertex is further than radius; weights must not be negative.
+ * The heap holds label ranks, not ids, so vertices at the same distance
+ * settle in label order and ties resolve the same way in every numbering
+ * @param start is where the search starts, scratch holds the state and
+ * masks, radius < 0 means no limit
+ */
+void CompactGraph::search(uint32_t start, SearchScratch &scratch,
+                          int radius) const {
+  typedef pair<int, uint32_t> Item;
+  auto &heap = scratch.heap;
+  auto later = greater<Item>();
+  bool stopAtTargets = scratch.targetsLeft > 0;
+  bool masked = !scratch.blockedVertex.empty();
+  heap.clear();
+  scratch.order.clear();
+  if (masked && scratch.blockedVertex[start]) {
+    return;
+  }
+  uint32_t generation = scratch.generation;
+  scratch.seen[start] = generation;
+  scratch.dist[start] = 0;
+  heap.emplace_back(0, labels.rank(start));
+  while (!heap.empty()) {
+    pop_heap(heap.begin(), heap.end(), later);
+    Item top = heap.back();
+    heap.pop_back();
+    uint32_t v = labels.byLabel(top.second);
+    if (scratch.done[v] == generation) {
+      continue;
+    }
+    if (radius >= 0 && top.first > radius) {
+      break;
+    }
+    scratch.done[v] = generation;
+    scratch.order.push_back(v);
+    if (stopAtTargets && scratch.target[v] == generation &&
+        --scratch.targetsLeft == 0) {
+      break;
+    }
+    for (uint64_t i = offsets[v]; i < offsets[v + 1]; i++) {
+      uint32_t n = targets[i];
+      if (scratch.done[n] == generation ||
+          (masked && (scratch.blockedEdge[i] || scratch.blockedVertex[n]))) {
+        continue;
+      }
+      int d = top.first + weights[i];
+      if (scratch.seen[n] != generation || d < scratch.dist[n]) {
+        scratch.seen[n] = generation;
+        scratch.dist[n] = d;
+        scratch.prev[n] = v;
+        heap.emplace_back(d, labels.rank(n));
+        push_heap(heap.begin(), heap.end(), later);
+      }
+    }
+  }
+}
+
+/* begin sizes the arrays for the graph and starts a new generation, the
+ * stamps are only cleared when the generation counter wraps around
+ * @param n is the number of vertices and e the number of stored edges
+ */
+void SearchScratch::begin(uint32_t n, uint64_t e) {
+  if (seen.size() != n) {
+    seen.assign(n, 0);
+    done.assign(n, 0);
+    dist.assign(n, 0);
+    prev.assign(n, 0);
+    target.clear();
+    blockedVertex.clear();
+    blockedEdge.clear();
+    generation = 0;
+  }
+  if (edges != e) {
+    edges = e;
+    blockedEdge.clear();
+  }
+  if (++generation == 0) {
+    fill(seen.begin(), seen.end(), 0);
+    fill(done.begin(), done.end(), 0);
+    fill(target.begin(), target.end(), 0);
+    generation = 1;
+  }
+  targetsLeft = 0;
+}
+
+// memoryBytes returns the heap bytes of the arrays
+size_t SearchScratch::memoryBytes() const {
+  return (seen.capacity() + done.capacity() + target.capacity() +
+          prev.capacity() + order.capacity()) * sizeof(uint32_t) +
+         dist.capacity() * sizeof(int) +
+         heap.capacity() * sizeof(pair<int, uint32_t>) +
+         blockedVertex.capacity() + blockedEdge.capacity();
+}
+
+// useMasks allocates the masks the first time a search needs them
+void SearchScratch::useMasks() {
+  if (blockedVertex.size() != seen.size()) {
+    blockedVertex.assign(seen.size(), 0);
+  }
+  if (blockedEdge.size() != edges) {
+    blockedEdge.assign(edges, 0);
+  }
+}
+
+// markTarget makes the next search stop once v and the other targets settle
+void SearchScratch::markTarget(uint32_t v) {
+  if (target.size() != seen.size()) {
+    target.assign(seen.size(), 0);
+  }
+  if (target[v] != generation) {
+    target[v] = generation;
+    targetsLeft++;
+  }
+}
+
+/* memoryUsage reports the heap bytes used by the arrays of this graph,
+ * the search scratch of dijkstra counts as per-vertex state
+ */
+MemoryUsage CompactGraph::memoryUsage() const {
+  MemoryUsage usage;
+  usage.vertices = offsets.capacity() * sizeof(uint64_t);
+  {
+    lock_guard<mutex> guard(scratchLock);
+    usage.vertices += scratch.memoryBytes();
+  }
+  usage.edges = targets.capacity() * sizeof(uint32_t) +
+                weights.capacity() * sizeof(int32_t);
+  usage.labels = labels.memoryBytes();
+  usage.overhead = 5 * MemoryUsage::kAllocOverhead;
+  return usage;
+}
+
+/* reorder computes the new numbering and permutes the arrays
+ * @param order is the numbering to use
+ */
+void CompactGraph::reorder(VertexOrder order) {
+  uint32_t n = verticesSize();
+  vector<uint32_t> newOrder(n);
+  for (uint32_t k = 0; k < n; k++) {
+    newOrder[k] = order == kOrderLabel ? labels.byLabel(k) : k;
+  }
+  if (order == kOrderDegree) {
+    stable_sort(newOrder.begin(), newOrder.end(),
+                [this](uint32_t a, uint32_t b) {
+                  return offsets[a + 1] - offsets[a] >
+                         offsets[b + 1] - offsets[b];
+                });
+  } else if (order == kOrderBfs) {
+    newOrder = breadthFirstOrder(false);
+  } else if (order == kOrderRcm) {
+    newOrder = breadthFirstOrder(true);
+    reverse(newOrder.begin(), newOrder.end());
+  }
+  permute(newOrder);
+}
+
+/* breadthFirstOrder lists the vertices in BFS discovery order over the out
+ * edges, restarting from the next unvisited vertex; for Cuthill-McKee each
+ * restart is the unvisited vertex of lowest degree and the neighbors of a
+ * vertex are queued by increasing degree
+ * @param cuthillMcKee selects the Cuthill-McKee rules
+ */
+vector<uint32_t> CompactGraph::breadthFirstOrder(bool cuthillMcKee) const {
+  uint32_t n = verticesSize();
+  auto degree = [this](uint32_t v) { return offsets[v + 1] - offsets[v]; };
+  vector<uint32_t> starts(n);
+  for (uint32_t v = 0; v < n; v++) {
+    starts[v] = v;
+  }
+  if (cuthillMcKee) {
+    stable_sort(starts.begin(), starts.end(), [&](uint32_t a, uint32_t b) {
+      return degree(a) < degree(b);
+    });
+  }
+
+  vector<char> visited(n, 0);
+  vector<uint32_t> order;
+  order.reserve(n);
+  for (auto &start : starts) {
+    if (visited[start]) {
+      continue;
+    }
+    visited[start] = 1;
+    order.push_back(start);
+    for (size_t head = order.size() - 1; head < order.size(); head++) {
+      uint32_t v = order[head];
+      size_t first = order.size();
+      for (uint64_t i = offsets[v]; i < offsets[v + 1]; i++) {
+        if (!visited[targets[i]]) {
+          visited[targets[i]] = 1;
+          order.push_back(targets[i]);
+        }
+      }
+      if (cuthillMcKee) {
+        stable_sort(order.begin() + first, order.end(),
+                    [&](uint32_t a, uint32_t b) {
+                      return degree(a) < degree(b);
+                    });
+      }
+    }
+  }
+  return order;
+}
+
+/* permute renumbers every vertex, the rows keep their edge order
+ * @param order lists the old ids in their new order
+ */
+void CompactGraph::permute(const vector<uint32_t> &order) {
+  uint32_t n = verticesSize();
+  vector<uint32_t> newId(n);
+  for (uint32_t k = 0; k < n; k++) {
+    newId[order[k]] = k;
+  }
+  vector<uint64_t> newOffsets;
+  vector<uint32_t> newTargets;
+  vector<int32_t> newWeights;
+  newOffsets.reserve(n + 1);
+  newTargets.reserve(targets.size());
+  newWeights.reserve(weights.size());
+  for (auto &old : order) {
+    newOffsets.push_back(newTargets.size());
+    for (uint64_t i = offsets[old]; i < offsets[old + 1]; i++) {
+      newTargets.push_back(newId[targets[i]]);
+      newWeights.push_back(weights[i]);
+    }
+  }
+  newOffsets.push_back(newTargets.size());
+  offsets.swap(newOffsets);
+  targets.swap(newTargets);
+  weights.swap(newWeights);
+  labels.permute(order);
+}
@@ -0,0 +1,198 @@
+/* @file compactgraph.h
+ * @brief The following code gives the declarations of the compact, read-only
+ * graph. Vertices are numbered by label order, adjacency is stored as
+ * offsets into one array of 32-bit target ids, weights live in a parallel
+ * array and all labels are packed into one string pool. reorder renumbers
+ * the vertices so neighbors get nearby ids; adjacency lists keep their
+ * label order and searches break distance ties by label, so every query
+ * returns the same results in any order.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#ifndef COMPACTGRAPH_H
+#define COMPACTGRAPH_H
+
+#include "edgereader.h"
+#include "labelpool.h"
+#include "memoryusage.h"
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class Graph;
+
+/* reusable state for heap-based searches on a CompactGraph, so repeated
+ * queries do not allocate or clear O(V) arrays: entries are only valid
+ * when their stamp equals the current generation. Masked vertices and
+ * edges are skipped by the search; whoever sets a mask clears it again.
+ * Target stamps and masks are only allocated once a search uses them.
+ * One scratch must not be used by two searches at the same time.
+ */
+struct SearchScratch {
+  // start a new search on a graph with n vertices and e stored edges
+  void begin(uint32_t n, uint64_t e);
+
+  // allocate cleared masks for the graph given to begin, if not done yet
+  void useMasks();
+
+  // stop the next search once v is settled, and every other marked target
+  void markTarget(uint32_t v);
+
+  // @return true if v was settled by the last search
+  bool settled(uint32_t v) const { return done[v] == generation; }
+
+  // @return heap bytes held by the arrays
+  size_t memoryBytes() const;
+
+  uint32_t generation = 0;
+
+  // dist and prev of v are valid when seen[v] == generation
+  vector<uint32_t> seen;
+
+  vector<uint32_t> done;
+
+  // empty until markTarget is called
+  vector<uint32_t> target;
+
+  vector<int> dist;
+
+  vector<uint32_t> prev;
+
+  // vertices in the order they were settled, dijkstra leaves their label
+  // ranks here instead
+  vector<uint32_t> order;
+
+  // binary min-heap of (distance, label rank of the vertex)
+  vector<pair<int, uint32_t>> heap;
+
+  size_t targetsLeft = 0;
+
+  // stored edges of the graph given to begin
+  uint64_t edges = 0;
+
+  // non-zero entries are skipped, empty until useMasks is called
+  vector<char> blockedVertex;
+
+  vector<char> blockedEdge;
+};
+
+// vertex numberings for CompactGraph::reorder
+enum VertexOrder {
+  // ids follow label order, the initial numbering
+  kOrderLabel,
+  // highest out-degree first, hubs share cache lines
+  kOrderDegree,
+  // breadth-first discovery order from each unvisited vertex in turn
+  kOrderBfs,
+  // reverse Cuthill-McKee, small bandwidth for mesh and road like graphs
+  kOrderRcm
+};
+
+class CompactGraph {
+  friend class CompressedGraph;
+  friend class PathFinder;
+  friend class NeighborhoodAnalytics;
+  friend class CentralityAnalytics;
+  friend class QueryExecutor;
+
+public:
+  // snapshot of graph, later changes to graph are not reflected
+  explicit CompactGraph(const Graph &graph);
+
+  // build straight from the edge list of reader, in the format and with the
+  // options of Graph::readStream, without building a Graph first; while
+  // reading only the labels and 12 bytes per stored edge are held, plus
+  // half of that again while the edges are sorted into rows
+  // result is set like Graph::readStream, edges before an error are kept
+  CompactGraph(EdgeReader &reader, ReadResult &result,
+               bool directionalEdges = true,
+               const ReadOptions &options = ReadOptions());
+
+  // copy not allowed
+  CompactGraph(const CompactGraph &other) = delete;
+
+  // move not allowed
+  CompactGraph(CompactGraph &&other) = delete;
+
+  // assignment not allowed
+  CompactGraph &operator=(const CompactGraph &other) = delete;
+
+  // move assignment not allowed
+  CompactGraph &operator=(CompactGraph &&other) = delete;
+
+  ~CompactGraph() = default;
+
+  // @return true if vertex is in the graph
+  bool contains(const string &label) const;
+
+  // @return total number of vertices
+  int verticesSize() const;
+
+  // @return total number of edges, counted the same way as Graph
+  long long edgesSize() const;
+
+  // @return number of edges from given vertex, -1 if vertex not found
+  int vertexDegree(const string &label) const;
+
+  // @return string representing edges and weights, "" if vertex not found
+  string getEdgesAsString(const string &label) const;
+
+  // depth-first traversal starting from given startLabel
+  void dfs(const string &startLabel, void visit(const string &label)) const;
+
+  // breadth-first traversal starting from startLabel
+  void bfs(const string &startLabel, void visit(const string &label)) const;
+
+  // dijkstra's algorithm using a binary heap, same weights as Graph,
+  // previous may name another vertex than Graph where two paths tie, but
+  // it is the same after any reorder
+  // the graph keeps O(V) search state for it, a call made while another
+  // thread uses that state allocates its own
+  pair<map<string, int>, map<string, string> >
+  dijkstra(const string &startLabel) const;
+
+  // dijkstra with state owned by the caller, so several threads can each
+  // reuse their own; scratch must not be used by another search meanwhile
+  pair<map<string, int>, map<string, string> >
+  dijkstra(const string &startLabel, SearchScratch &scratch) const;
+
+  // @return heap bytes used by this graph, by category
+  MemoryUsage memoryUsage() const;
+
+  // renumber the vertices to improve the locality of traversals
+  // labels and the results of every query stay the same
+  void reorder(VertexOrder order);
+
+private:
+  bool directionalEdges;
+
+  long long numberOfEdges;
+
+  // neighbors of v are targets[offsets[v]] .. targets[offsets[v + 1] - 1],
+  // 64-bit so more than 4G edges can be stored
+  vector<uint64_t> offsets;
+
+  vector<uint32_t> targets;
+
+  vector<int32_t> weights;
+
+  LabelPool labels;
+
+  // guards scratch, which dijkstra without a scratch argument reuses
+  mutable mutex scratchLock;
+
+  mutable SearchScratch scratch;
+
+  vector<uint32_t> breadthFirstOrder(bool cuthillMcKee) const;
+
+  void search(uint32_t start, SearchScratch &scratch, int radius) const;
+
+  void permute(const vector<uint32_t> &order);
+};
+
+#endif // COMPACTGRAPH_H
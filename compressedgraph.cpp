@@ -0,0 +1,245 @@
+/* @file compressedgraph.cpp
+ * @brief The following code gives the implementations of the compressed,
+ * read-only graph.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "compressedgraph.h"
+#include "compactgraph.h"
+#include <functional>
+#include <queue>
+#include <utility>
+
+using namespace std;
+
+/* constructor encodes every adjacency list of graph, picking the narrowest
+ * weight width that holds all weights
+ * @param graph is the graph being compressed
+ */
+CompressedGraph::CompressedGraph(const CompactGraph &graph)
+    : numberOfEdges(graph.numberOfEdges), weightBytes(0),
+      labels(graph.labels) {
+  for (auto &w : graph.weights) {
+    if (w < -32768 || w > 32767) {
+      weightBytes = 4;
+    } else if ((w < -128 || w > 127) && weightBytes < 2) {
+      weightBytes = 2;
+    } else if (w != 0 && weightBytes < 1) {
+      weightBytes = 1;
+    }
+  }
+
+  uint32_t n = graph.verticesSize();
+  rowOffsets.reserve(n + 1);
+  // most gaps of a sorted list fit in one or two bytes
+  bytes.reserve(graph.targets.size() * (1 + weightBytes) + n);
+  for (uint32_t v = 0; v < n; v++) {
+    rowOffsets.push_back(bytes.size());
+    appendVarint(graph.offsets[v + 1] - graph.offsets[v]);
+    int64_t last = v;
+    for (uint64_t i = graph.offsets[v]; i < graph.offsets[v + 1]; i++) {
+      int64_t gap = static_cast<int64_t>(graph.targets[i]) - last;
+      last = graph.targets[i];
+      // zigzag so small negative gaps also take one byte
+      appendVarint((static_cast<uint64_t>(gap) << 1) ^
+                   static_cast<uint64_t>(gap >> 63));
+      auto w = static_cast<uint32_t>(graph.weights[i]);
+      for (int b = 0; b < weightBytes; b++) {
+        bytes.push_back(static_cast<uint8_t>(w >> (8 * b)));
+      }
+    }
+  }
+  rowOffsets.push_back(bytes.size());
+  bytes.shrink_to_fit();
+}
+
+// appendVarint writes value 7 bits at a time, low bits first
+void CompressedGraph::appendVarint(uint64_t value) {
+  while (value >= 0x80) {
+    bytes.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  bytes.push_back(static_cast<uint8_t>(value));
+}
+
+// neighbors returns a cursor positioned before the first neighbor of id
+NeighborCursor CompressedGraph::neighbors(uint32_t id) const {
+  NeighborCursor cursor;
+  cursor.p = bytes.data() + rowOffsets[id];
+  cursor.weightBytes = weightBytes;
+  cursor.last = id;
+  cursor.remaining = static_cast<uint32_t>(cursor.readVarint());
+  return cursor;
+}
+
+// weightWidth returns the bytes used to store each weight
+int CompressedGraph::weightWidth() const { return weightBytes; }
+
+// verticesSize returns the total number of vertices
+int CompressedGraph::verticesSize() const {
+  return static_cast<int>(rowOffsets.size()) - 1;
+}
+
+// edgesSize returns the total number of edges
+long long CompressedGraph::edgesSize() const { return numberOfEdges; }
+
+// contains checks if a vertex is in the graph
+bool CompressedGraph::contains(const string &label) const {
+  uint32_t id = 0;
+  return labels.find(label, id);
+}
+
+// vertexDegree returns the number of edges from given vertex, -1 if not found
+int CompressedGraph::vertexDegree(const string &label) const {
+  uint32_t id = 0;
+  if (!labels.find(label, id)) {
+    return -1;
+  }
+  return neighbors(id).left();
+}
+
+/* getEdgesAsString creates a string of edges and weights
+ * A-3->B, A-5->C should return B(3),C(5)
+ * @param label is the string referenced
+ */
+string CompressedGraph::getEdgesAsString(const string &label) const {
+  string s;
+  uint32_t id = 0;
+  if (!labels.find(label, id)) {
+    return s;
+  }
+  NeighborCursor cursor = neighbors(id);
+  uint32_t target = 0;
+  int32_t weight = 0;
+  while (cursor.next(target, weight)) {
+    if (!s.empty()) {
+      s += ",";
+    }
+    s += labels.label(target) + "(" + to_string(weight) + ")";
+  }
+  return s;
+}
+
+/* dfs visits vertices in the same order as Graph::dfs, keeping a cursor per
+ * vertex on the stack so each list is decoded once
+ * @param startLabel is where the traversal starts and calls visit
+ */
+void CompressedGraph::dfs(const string &startLabel,
+                          void visit(const string &label)) const {
+  uint32_t start = 0;
+  if (!labels.find(startLabel, start)) {
+    return;
+  }
+  vector<char> visited(verticesSize(), 0);
+  vector<NeighborCursor> stack;
+  visited[start] = 1;
+  visit(labels.label(start));
+  stack.push_back(neighbors(start));
+  uint32_t n = 0;
+  int32_t weight = 0;
+  while (!stack.empty()) {
+    if (!stack.back().next(n, weight)) {
+      stack.pop_back();
+      continue;
+    }
+    if (!visited[n]) {
+      visited[n] = 1;
+      visit(labels.label(n));
+      stack.push_back(neighbors(n));
+    }
+  }
+}
+
+/* bfs is the implementation of a breadth first search
+ * @param startLabel is where the traversal starts and calls visit
+ */
+void CompressedGraph::bfs(const string &startLabel,
+                          void visit(const string &label)) const {
+  uint32_t start = 0;
+  if (!labels.find(startLabel, start)) {
+    return;
+  }
+  vector<char> visited(verticesSize(), 0);
+  vector<uint32_t> q;
+  q.reserve(verticesSize());
+  visited[start] = 1;
+  q.push_back(start);
+  uint32_t n = 0;
+  int32_t weight = 0;
+  for (size_t head = 0; head < q.size(); head++) {
+    uint32_t v = q[head];
+    visit(labels.label(v));
+    NeighborCursor cursor = neighbors(v);
+    while (cursor.next(n, weight)) {
+      if (!visited[n]) {
+        visited[n] = 1;
+        q.push_back(n);
+      }
+    }
+  }
+}
+
+/* dijkstra finds the shortest distance and previous vertex for every vertex
+ * reachable from startLabel, the start vertex itself is not reported
+ * @param startLabel is where the search starts
+ */
+pair<map<string, int>, map<string, string>>
+CompressedGraph::dijkstra(const string &startLabel) const {
+  map<string, int> weightsMap;
+  map<string, string> previous;
+  uint32_t start = 0;
+  if (!labels.find(startLabel, start)) {
+    return make_pair(weightsMap, previous);
+  }
+
+  const int unreached = -1;
+  vector<int> dist(verticesSize(), unreached);
+  vector<uint32_t> prev(verticesSize(), 0);
+  vector<char> settled(verticesSize(), 0);
+  // (distance, label rank), so ties settle like CompactGraph::dijkstra
+  typedef pair<int, uint32_t> Item;
+  priority_queue<Item, vector<Item>, greater<Item>> heap;
+  dist[start] = 0;
+  heap.emplace(0, labels.rank(start));
+  uint32_t n = 0;
+  int32_t weight = 0;
+  while (!heap.empty()) {
+    Item top = heap.top();
+    heap.pop();
+    uint32_t v = labels.byLabel(top.second);
+    if (settled[v]) {
+      continue;
+    }
+    settled[v] = 1;
+    NeighborCursor cursor = neighbors(v);
+    while (cursor.next(n, weight)) {
+      int d = top.first + weight;
+      if (!settled[n] && (dist[n] == unreached || d < dist[n])) {
+        dist[n] = d;
+        prev[n] = v;
+        heap.emplace(d, labels.rank(n));
+      }
+    }
+  }
+  // walk the vertices in label order so every insert goes at the end
+  for (uint32_t k = 0; k < settled.size(); k++) {
+    uint32_t v = labels.byLabel(k);
+    if (settled[v] && v != start) {
+      string name = labels.label(v);
+      weightsMap.emplace_hint(weightsMap.end(), name, dist[v]);
+      previous.emplace_hint(previous.end(), name, labels.label(prev[v]));
+    }
+  }
+  return make_pair(weightsMap, previous);
+}
+
+// memoryUsage reports the heap bytes used by the arrays of this graph
+MemoryUsage CompressedGraph::memoryUsage() const {
+  MemoryUsage usage;
+  usage.vertices = rowOffsets.capacity() * sizeof(uint64_t);
+  usage.edges = bytes.capacity();
+  usage.labels = labels.memoryBytes();
+  usage.overhead = 4 * MemoryUsage::kAllocOverhead;
+  return usage;
+}
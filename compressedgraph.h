@@ -0,0 +1,154 @@
+/* @file compressedgraph.h
+ * @brief The following code gives the declarations of the compressed,
+ * read-only graph. Each adjacency list is stored as a byte stream: the
+ * degree, then for every edge the zigzag varint gap from the previous target
+ * (the first gap is taken from the vertex itself) followed by the weight in
+ * the narrowest fixed width that fits every weight of the graph, 0 bytes
+ * when all weights are 0.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#ifndef COMPRESSEDGRAPH_H
+#define COMPRESSEDGRAPH_H
+
+#include "labelpool.h"
+#include "memoryusage.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class CompactGraph;
+
+// decodes the adjacency list of one vertex, in the same order as Graph
+class NeighborCursor {
+  friend class CompressedGraph;
+
+public:
+  // @return false when the list is done, otherwise sets target and weight
+  bool next(uint32_t &target, int32_t &weight) {
+    if (remaining == 0) {
+      return false;
+    }
+    remaining--;
+    last = static_cast<uint32_t>(last + unzigzag(readVarint()));
+    target = last;
+    weight = 0;
+    if (weightBytes > 0) {
+      uint32_t w = 0;
+      for (int i = 0; i < weightBytes; i++) {
+        w |= static_cast<uint32_t>(*p++) << (8 * i);
+      }
+      // sign extend narrow weights
+      int shift = 32 - 8 * weightBytes;
+      weight = static_cast<int32_t>(w << shift) >> shift;
+    }
+    return true;
+  }
+
+  // @return number of neighbors not yet decoded
+  uint32_t left() const { return remaining; }
+
+private:
+  const uint8_t *p = nullptr;
+  uint32_t remaining = 0;
+  uint32_t last = 0;
+  int weightBytes = 0;
+
+  uint64_t readVarint() {
+    uint64_t value = *p++;
+    if (value < 0x80) {
+      return value;
+    }
+    value &= 0x7f;
+    for (int shift = 7;; shift += 7) {
+      uint64_t byte = *p++;
+      value |= (byte & 0x7f) << shift;
+      if (byte < 0x80) {
+        return value;
+      }
+    }
+  }
+
+  static int64_t unzigzag(uint64_t v) {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+  }
+};
+
+class CompressedGraph {
+public:
+  // compresses graph, vertex ids are the same as in graph
+  // graph and the compressed copy are both held until this returns, so the
+  // peak is the CSR arrays plus the compressed bytes; to stay below that,
+  // build graph from an EdgeReader and destroy it once compressed
+  // gaps are smallest when graph is still in label order: after reorder
+  // rows are not sorted by id and many gaps are negative or large
+  explicit CompressedGraph(const CompactGraph &graph);
+
+  // copy not allowed
+  CompressedGraph(const CompressedGraph &other) = delete;
+
+  // move not allowed
+  CompressedGraph(CompressedGraph &&other) = delete;
+
+  // assignment not allowed
+  CompressedGraph &operator=(const CompressedGraph &other) = delete;
+
+  // move assignment not allowed
+  CompressedGraph &operator=(CompressedGraph &&other) = delete;
+
+  ~CompressedGraph() = default;
+
+  // @return true if vertex is in the graph
+  bool contains(const string &label) const;
+
+  // @return total number of vertices
+  int verticesSize() const;
+
+  // @return total number of edges, counted the same way as Graph
+  long long edgesSize() const;
+
+  // @return number of edges from given vertex, -1 if vertex not found
+  int vertexDegree(const string &label) const;
+
+  // @return string representing edges and weights, "" if vertex not found
+  string getEdgesAsString(const string &label) const;
+
+  // depth-first traversal starting from given startLabel
+  void dfs(const string &startLabel, void visit(const string &label)) const;
+
+  // breadth-first traversal starting from startLabel
+  void bfs(const string &startLabel, void visit(const string &label)) const;
+
+  // dijkstra's algorithm using a binary heap
+  pair<map<string, int>, map<string, string> >
+  dijkstra(const string &startLabel) const;
+
+  // @return a cursor over the neighbors of vertex id
+  NeighborCursor neighbors(uint32_t id) const;
+
+  // @return bytes used to store each weight, 0, 1, 2 or 4
+  int weightWidth() const;
+
+  // @return heap bytes used by this graph, by category
+  MemoryUsage memoryUsage() const;
+
+private:
+  long long numberOfEdges;
+
+  int weightBytes;
+
+  // adjacency of v is encoded in bytes[rowOffsets[v]] .. bytes[rowOffsets[v + 1]]
+  vector<uint64_t> rowOffsets;
+
+  vector<uint8_t> bytes;
+
+  LabelPool labels;
+
+  void appendVarint(uint64_t value);
+};
+
+#endif // COMPRESSEDGRAPH_H
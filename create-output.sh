@@ -59,7 +59,7 @@ echo "====================================================="
 echo "1. Compiles without warnings with -Wall -Wextra flags"
 echo "====================================================="
 
-g++ -g -std=c++11 -Wall -Wextra -Wno-sign-compare *.cpp
+g++ -g -std=c++11 -pthread -Wall -Wextra -Wno-sign-compare *.cpp
 
 echo "====================================================="
 echo "2. Runs and produces correct output"
@@ -100,7 +100,7 @@ echo "====================================================="
 
 rm ./a.out 2>/dev/null
 
-g++ -std=c++11 -fsanitize=address -fno-omit-frame-pointer -g *.cpp
+g++ -std=c++11 -pthread -fsanitize=address -fno-omit-frame-pointer -g *.cpp
 # Execute program
 $EXEC_PROGRAM > /dev/null 2> /dev/null
 
@@ -112,7 +112,7 @@ echo "====================================================="
 rm ./a.out 2>/dev/null
 
 if hash valgrind 2>/dev/null; then
-  g++ -g -std=c++11 *.cpp
+  g++ -g -std=c++11 -pthread *.cpp
   # redirect program output to /dev/null will running valgrind
   valgrind --log-file="valgrind-output.txt" $EXEC_PROGRAM > /dev/null 2>/dev/null
   cat valgrind-output.txt
@@ -12,6 +12,7 @@ class Vertex;
 class Edge {
   friend class Vertex;
   friend class Graph;
+  friend class CompactGraph;
 
  private:
   int weight = 0;
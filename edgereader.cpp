@@ -0,0 +1,244 @@
+/* @file edgereader.cpp
+ * @brief The following code gives the implementations of the buffered edge
+ * list reader.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "edgereader.h"
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <unistd.h>
+
+using namespace std;
+
+// reader for an input stream
+EdgeReader::EdgeReader(istream &in, size_t blockSize)
+    : in(&in), fd(-1), buffer(blockSize > 0 ? blockSize : 1) {}
+
+// reader for a file descriptor
+EdgeReader::EdgeReader(int fd, size_t blockSize)
+    : in(nullptr), fd(fd), buffer(blockSize > 0 ? blockSize : 1) {}
+
+/* fill moves the unread bytes to the front of the buffer and reads the next
+ * block after them, the buffer only grows when one line is longer than it
+ * @return false if nothing more could be read
+ */
+bool EdgeReader::fill() {
+  if (eof) {
+    return false;
+  }
+  if (pos > 0) {
+    memmove(buffer.data(), buffer.data() + pos, len - pos);
+    len -= pos;
+    pos = 0;
+  }
+  if (len == buffer.size()) {
+    buffer.resize(buffer.size() * 2);
+  }
+  size_t room = buffer.size() - len;
+  long long got = 0;
+  if (in != nullptr) {
+    in->read(buffer.data() + len, room);
+    got = in->gcount();
+    if (in->bad()) {
+      error = true;
+    }
+  } else {
+    ssize_t n = 0;
+    do {
+      n = read(fd, buffer.data() + len, room);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+      error = true;
+    }
+    got = n < 0 ? 0 : n;
+  }
+  if (got <= 0) {
+    eof = true;
+    return false;
+  }
+  len += got;
+  bytes += got;
+  return true;
+}
+
+/* nextLine finds the next line break in the buffer, reading more input when
+ * the line is not complete yet; the last line may have no line break
+ */
+bool EdgeReader::nextLine(const char *&begin, const char *&end) {
+  size_t searched = pos;
+  while (true) {
+    auto *nl = static_cast<const char *>(
+        memchr(buffer.data() + searched, '\n', len - searched));
+    if (nl != nullptr) {
+      begin = buffer.data() + pos;
+      end = nl;
+      pos = nl - buffer.data() + 1;
+      line++;
+      return true;
+    }
+    searched = len - pos;
+    if (!fill()) {
+      break;
+    }
+  }
+  if (pos == len) {
+    return false;
+  }
+  begin = buffer.data() + pos;
+  end = buffer.data() + len;
+  pos = len;
+  line++;
+  return true;
+}
+
+// lineNumber returns the number of the line last returned
+long long EdgeReader::lineNumber() const { return line; }
+
+// bytesRead returns the bytes read from the input so far
+long long EdgeReader::bytesRead() const { return bytes; }
+
+// failed returns true if the input reported an error
+bool EdgeReader::failed() const { return error; }
+
+// split stores the whitespace separated tokens of [begin, end)
+size_t EdgeReader::split(const char *begin, const char *end,
+                         pair<const char *, const char *> *tokens,
+                         size_t maxTokens) {
+  size_t count = 0;
+  const char *p = begin;
+  while (true) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+      p++;
+    }
+    if (p == end) {
+      return count;
+    }
+    if (count == maxTokens) {
+      return maxTokens + 1;
+    }
+    const char *start = p;
+    while (p < end && *p != ' ' && *p != '\t' && *p != '\r') {
+      p++;
+    }
+    tokens[count++] = make_pair(start, p);
+  }
+}
+
+// parseInt reads an optionally signed decimal integer that fits in an int
+bool EdgeReader::parseInt(const char *begin, const char *end, int &value) {
+  const char *p = begin;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = *p == '-';
+    p++;
+  }
+  if (p == end) {
+    return false;
+  }
+  long long result = 0;
+  for (; p < end; p++) {
+    if (*p < '0' || *p > '9') {
+      return false;
+    }
+    result = result * 10 + (*p - '0');
+    if (result > static_cast<long long>(INT_MAX) + 1) {
+      return false;
+    }
+  }
+  result = negative ? -result : result;
+  if (result > INT_MAX || result < INT_MIN) {
+    return false;
+  }
+  value = static_cast<int>(result);
+  return true;
+}
+
+/* readEdgeList parses lines into a batch and hands the batch to apply
+ * whenever it is full, so only one block and one batch are held
+ * @param reader is the input, options are the read settings, apply uses
+ * and empties each batch
+ */
+ReadResult readEdgeList(
+    EdgeReader &reader, const ReadOptions &options,
+    const function<void(vector<EdgeRecord> &batch, ReadResult &result)>
+        &apply) {
+  ReadResult result;
+  vector<EdgeRecord> batch;
+  batch.reserve(options.batchSize > 0 ? options.batchSize : 1);
+  pair<const char *, const char *> tokens[3];
+  const char *begin = nullptr;
+  const char *end = nullptr;
+  bool first = true;
+  long long limit = -1;
+
+  while (limit < 0 || result.edgesRead < limit) {
+    if (!reader.nextLine(begin, end)) {
+      break;
+    }
+    size_t count = EdgeReader::split(begin, end, tokens, 3);
+    if (count == 0 || (options.comments && *tokens[0].first == '#')) {
+      continue;
+    }
+    if (first && options.header != kHeaderNone) {
+      first = false;
+      int edges = 0;
+      bool isCount = count == 1 &&
+                     EdgeReader::parseInt(tokens[0].first, tokens[0].second,
+                                          edges) &&
+                     edges >= 0;
+      if (options.header == kHeaderCount && !isCount) {
+        result.ok = false;
+        result.error = "expected the number of edges";
+        break;
+      }
+      if (isCount) {
+        if (options.header != kHeaderSkip) {
+          limit = edges;
+        }
+        continue;
+      }
+    }
+    first = false;
+    EdgeRecord record;
+    if (count != 3 || !EdgeReader::parseInt(tokens[2].first,
+                                            tokens[2].second, record.weight)) {
+      result.ok = false;
+      result.error = "expected \"from to weight\"";
+      break;
+    }
+    record.from.assign(tokens[0].first, tokens[0].second);
+    record.to.assign(tokens[1].first, tokens[1].second);
+    batch.push_back(move(record));
+    result.edgesRead++;
+    if (batch.size() >= options.batchSize) {
+      result.bytesRead = reader.bytesRead();
+      apply(batch, result);
+      if (options.progress != nullptr) {
+        options.progress(result.edgesRead, result.bytesRead);
+      }
+    }
+  }
+
+  if (result.ok && reader.failed()) {
+    result.ok = false;
+    result.error = "read error";
+  } else if (result.ok && result.edgesRead < limit) {
+    result.ok = false;
+    result.error = "expected " + to_string(limit) + " edges, found " +
+                   to_string(result.edgesRead);
+  }
+  if (!result.ok) {
+    result.line = reader.lineNumber();
+  }
+  result.bytesRead = reader.bytesRead();
+  if (!batch.empty()) {
+    apply(batch, result);
+    if (options.progress != nullptr) {
+      options.progress(result.edgesRead, result.bytesRead);
+    }
+  }
+  return result;
+}
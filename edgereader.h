@@ -0,0 +1,140 @@
+/* @file edgereader.h
+ * @brief The following code gives the declarations of the buffered edge
+ * list reader used by Graph::readStream and Graph::readFd. Input is read in
+ * large blocks and split into lines in place, so memory use depends on the
+ * block size and the longest line, not on the size of the input.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#ifndef EDGEREADER_H
+#define EDGEREADER_H
+
+#include <functional>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// how the first line of an edge list is treated
+enum HeaderMode {
+  // a first line holding only an integer is the edge count, read that many
+  // edges and ignore the rest; without it read every line
+  kHeaderAuto,
+  // the first line must be the edge count, like readFile
+  kHeaderCount,
+  // a first line holding only an integer is skipped, read every line
+  kHeaderSkip,
+  // every line is an edge
+  kHeaderNone
+};
+
+// settings for Graph::readStream and Graph::readFd
+struct ReadOptions {
+  HeaderMode header = kHeaderAuto;
+
+  // bytes read from the input at a time
+  size_t blockSize = 1 << 20;
+
+  // edges parsed before they are connected
+  size_t batchSize = 4096;
+
+  // skip lines whose first token starts with #, readFile turns this off
+  // because its labels may start with #
+  bool comments = true;
+
+  // called after every batch with edges read and bytes read so far
+  void (*progress)(long long edges, long long bytes) = nullptr;
+};
+
+// outcome of Graph::readStream and Graph::readFd
+struct ReadResult {
+  // false if the input could not be read or a line could not be parsed
+  bool ok = true;
+
+  // line of the error, 0 if none
+  long long line = 0;
+
+  // description of the error, "" if none
+  string error;
+
+  // edge lines read and edges that connect added
+  long long edgesRead = 0;
+
+  long long edgesAdded = 0;
+
+  long long bytesRead = 0;
+};
+
+// one "from to weight" line
+struct EdgeRecord {
+  string from;
+  string to;
+  int weight = 0;
+};
+
+class EdgeReader {
+public:
+  // read from in, which must outlive the reader
+  EdgeReader(istream &in, size_t blockSize);
+
+  // read from the open file descriptor fd, which is not closed
+  EdgeReader(int fd, size_t blockSize);
+
+  // @return false at the end of the input, otherwise sets begin and end to
+  // the next line without its line break, valid until the next call
+  bool nextLine(const char *&begin, const char *&end);
+
+  // @return number of the line last returned, starting at 1
+  long long lineNumber() const;
+
+  // @return bytes read from the input so far
+  long long bytesRead() const;
+
+  // @return true if reading failed, not just reached the end
+  bool failed() const;
+
+  // split a line into at most maxTokens whitespace separated tokens
+  // @return number of tokens, maxTokens + 1 if there are more
+  static size_t split(const char *begin, const char *end,
+                      pair<const char *, const char *> *tokens,
+                      size_t maxTokens);
+
+  // parse a whole token as an int
+  // @return false if it is not an integer or does not fit in an int
+  static bool parseInt(const char *begin, const char *end, int &value);
+
+private:
+  istream *in;
+
+  int fd;
+
+  vector<char> buffer;
+
+  // unread bytes are buffer[pos] .. buffer[len - 1]
+  size_t pos = 0;
+
+  size_t len = 0;
+
+  bool eof = false;
+
+  bool error = false;
+
+  long long line = 0;
+
+  long long bytes = 0;
+
+  bool fill();
+};
+
+// parse the edge list of reader as Graph::readStream does, apply is called
+// with each full batch and the result so far and must empty the batch
+// @return result with ok false and the line number on error
+ReadResult readEdgeList(
+    EdgeReader &reader, const ReadOptions &options,
+    const function<void(vector<EdgeRecord> &batch, ReadResult &result)>
+        &apply);
+
+#endif // EDGEREADER_H
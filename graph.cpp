@@ -25,6 +25,11 @@ Graph::Graph(bool directionalEdges) {
     this->directionalEdges = directionalEdges;
     numberOfVertices = 0;
     numberOfEdges = 0;
+    currentVersion = 0;
+    forgotten = 0;
+#ifdef GRAPH_INSTRUMENT
+    counters.reset(new GraphCounters());
+#endif
 }
 
 // destructor
@@ -37,6 +42,7 @@ Graph::~Graph() {
     delete temp;
   }
   vertices.clear();
+  index.clear();
   numberOfVertices = 0;
   numberOfEdges = 0;
 
@@ -56,6 +62,7 @@ int Graph::edgesSize() const {
  * @param label is the string referenced
  */
 int Graph::vertexDegree(const string &label) const { 
+  GRAPH_TIME(kOpVertexDegree);
   Vertex *v = nullptr;
   if (this->find(label, v)) {
     return v->neighbors.size();
@@ -68,10 +75,16 @@ int Graph::vertexDegree(const string &label) const {
  * @param label is the string referenced
  */
 bool Graph::add(const string &label) { 
+  GRAPH_TIME(kOpAdd);
   if (!this->contains(label)) {
     auto v = new Vertex(label);
+    GRAPH_COUNT(allocations, 1);
+    GRAPH_COUNT(allocatedBytes, sizeof(Vertex));
     vertices.push_back(v);
+    index.emplace(label, v);
     numberOfVertices++;
+    // searches from label found nothing before, so it counts as a change
+    recordChange(label);
     return true; 
   }
     return false;
@@ -82,12 +95,9 @@ bool Graph::add(const string &label) {
  * @param label is the string reference
  */
 bool Graph::contains(const string &label) const {
-  for (auto &v : vertices) {
-    if (v->label == label) {
-      return true;
-    }
-  }
-  return false;
+  GRAPH_TIME(kOpContains);
+  Vertex *v = nullptr;
+  return find(label, v);
 }
 
 /* getEdgesAsString creates a string of edges and weights, it returns
@@ -96,6 +106,7 @@ bool Graph::contains(const string &label) const {
  * @param label is the string referenced
  */
 string Graph::getEdgesAsString(const string &label) const { 
+  GRAPH_TIME(kOpEdgesAsString);
   string s; 
   Vertex *v = nullptr;
   if(this->find(label, v)) {
@@ -120,6 +131,7 @@ string Graph::getEdgesAsString(const string &label) const {
  * @param strings from and to are the references and weight is the weight of edge
  */
 bool Graph::connect(const string &from, const string &to, int weight) {
+  GRAPH_TIME(kOpConnect);
   if(from == to) {
     return false;
   }
@@ -128,22 +140,33 @@ bool Graph::connect(const string &from, const string &to, int weight) {
 
   if(!find(from, v1)) {
     v1 = new Vertex(from);
+    GRAPH_COUNT(allocations, 1);
+    GRAPH_COUNT(allocatedBytes, sizeof(Vertex));
     vertices.push_back(v1);
+    index.emplace(from, v1);
     numberOfVertices++;
+    recordChange(from);
   }
 
   if(!find(to, v2)) {
     v2 = new Vertex(to);
+    GRAPH_COUNT(allocations, 1);
+    GRAPH_COUNT(allocatedBytes, sizeof(Vertex));
     vertices.push_back(v2);
+    index.emplace(to, v2);
     numberOfVertices++;
+    recordChange(to);
   }
   
   bool c1 = false;
   bool c2 = false;
   auto e1 = new Edge (v1, v2, weight);
+  GRAPH_COUNT(allocations, 1);
+  GRAPH_COUNT(allocatedBytes, sizeof(Edge));
 
   for(int i = 0; i < v1->neighbors.size(); i++) {
     Edge *temp = v1->neighbors.at(i);
+    GRAPH_COUNT(edgesScanned, 1);
     if (from == temp->from->label && to == temp->to->label) {
       delete e1;
       return false;
@@ -163,13 +186,16 @@ bool Graph::connect(const string &from, const string &to, int weight) {
 
   if(!directionalEdges) {
     auto e2 = new Edge(v2, v1, weight);
+    GRAPH_COUNT(allocations, 1);
+    GRAPH_COUNT(allocatedBytes, sizeof(Edge));
     for (int i = 0; i < v2->neighbors.size(); i++) {
       Edge *temp = v2->neighbors.at(i);
+      GRAPH_COUNT(edgesScanned, 1);
       if(from == temp->from->label && to == temp->to->label) {
         delete e2;
         return false;
       } 
-      if (to < temp->to->label) {
+      if (from < temp->to->label) {
         v2->neighbors.insert(v2->neighbors.begin() + i, e2);
         c2 = true;
         break;
@@ -178,7 +204,9 @@ bool Graph::connect(const string &from, const string &to, int weight) {
     if (!c2) {
       v2->neighbors.push_back(e2);
     }
+    recordChange(to);
   }
+  recordChange(from);
   return true;
 }
 
@@ -187,6 +215,7 @@ bool Graph::connect(const string &from, const string &to, int weight) {
  * @param string from and to are references
  */
 bool Graph::disconnect(const string &from, const string &to) { 
+  GRAPH_TIME(kOpDisconnect);
   Vertex *v = nullptr;
   if (!find(from, v)) {
     return false;
@@ -194,6 +223,7 @@ bool Graph::disconnect(const string &from, const string &to) {
 
   for (int i = 0; i < v->neighbors.size(); i++) {
     Edge *e = v->neighbors.at(i);
+    GRAPH_COUNT(edgesScanned, 1);
     if (from == e->from->label && to == e->to->label) {
       v->neighbors.erase(v->neighbors.begin() + i);
       delete e;
@@ -203,13 +233,16 @@ bool Graph::disconnect(const string &from, const string &to) {
         find(to, v2);
         for (int j = 0; j < v2->neighbors.size(); j++) {
           Edge *e2 = v2->neighbors.at(j);
+          GRAPH_COUNT(edgesScanned, 1);
           if (to == e2->from->label && from == e2->to->label) {
             v2->neighbors.erase(v2->neighbors.begin() + j);
             delete e2;
             break;
           }
        } 
+       recordChange(to);
       } 
+    recordChange(from);
     return true;
    }
   }
@@ -222,6 +255,7 @@ return false;
  * @param startLabel is where the traversal starts and calls visit
  */
 void Graph::dfs(const string &startLabel, void visit(const string &label)) {
+  GRAPH_TIME(kOpDfs);
   for (auto &v : vertices) {
     v->visited = false;
   }
@@ -243,6 +277,7 @@ void Graph::dfsHelper(Vertex *v, void visit(const string &label)) {
   v->visited = true;
   visit(v->label);
   for (auto &neighbor : v->neighbors) {
+    GRAPH_COUNT(edgesScanned, 1);
     Vertex *temp = neighbor->to;
     if (!temp->visited) {
       dfsHelper(temp, visit);
@@ -254,6 +289,7 @@ void Graph::dfsHelper(Vertex *v, void visit(const string &label)) {
  * @param startLabel is where the traversal starts and calls visit
  */
 void Graph::bfs(const string &startLabel, void visit(const string &label)) {
+  GRAPH_TIME(kOpBfs);
   for (auto &v : vertices) {
     v->visited = false;
   }
@@ -270,6 +306,7 @@ void Graph::bfs(const string &startLabel, void visit(const string &label)) {
     q.pop();
     visit(temp->label);
     for(auto &neighbor :temp->neighbors) {
+      GRAPH_COUNT(edgesScanned, 1);
       Vertex *n = neighbor->to;
       if(!n->visited) {
         n->visited = true;
@@ -286,6 +323,7 @@ void Graph::bfs(const string &startLabel, void visit(const string &label)) {
  */
 pair<map<string, int>, map<string, string>>
 Graph::dijkstra(const string &startLabel) const {
+  GRAPH_TIME(kOpDijkstra);
   map<string, int> weights;
   map<string, string> previous;
   for (auto &v : vertices) {
@@ -308,6 +346,8 @@ Graph::dijkstra(const string &startLabel) const {
     }
     e->to->visited = true;
     visitedArray.push_back(e->to);
+    GRAPH_COUNT(edgesRelaxed, 1);
+    GRAPH_COUNT(mapInserts, 2);
 
     auto it = weights.find(e->from->label);
     if (it == weights.end()) {
@@ -325,10 +365,11 @@ Graph::dijkstra(const string &startLabel) const {
  * neighbor vector and returns it 
  * @param visited array vector
  */
-vector<Edge *> Graph::dijakstraNeighborHelper(vector<Vertex *> visitedArray) {
+vector<Edge *> Graph::dijakstraNeighborHelper(vector<Vertex *> visitedArray) const {
   vector<Edge *> smallestEdge;
   for (int i = 0; i < visitedArray.size(); i++) {
   vector<Edge *> n = visitedArray.at(i)->neighbors;
+  GRAPH_COUNT(edgesScanned, n.size());
   Edge *min; 
   if (n.empty()) {
     visitedArray.erase(visitedArray.begin() + i);
@@ -386,35 +427,150 @@ Edge *Graph::dijakstraDistanceHelper(vector<Edge *> smallestEdge, map<string, in
   return min;
 }
 
-/* find looks for a specific edge in the graph
+/* find looks for a specific vertex in the graph using the label index
  * @param label is the string being referenced
  */
 bool Graph::find(const string &label, Vertex *&vertex) const {
-  for (auto &v : vertices) {
-    if (v->label == label) {
-      vertex = v; 
-      return true;
-    }
+  GRAPH_COUNT(findCalls, 1);
+  auto it = index.find(label);
+  if (it == index.end()) {
+    return false;
   }
-  return false;
+  vertex = it->second;
+  return true;
 }
 
 // read a text file and create the graph
 bool Graph::readFile(const string &filename) {
+  GRAPH_TIME(kOpReadFile);
   ifstream myfile(filename);
   if (!myfile.is_open()) {
     cerr << "Failed to open " << filename << endl;
     return false;
   }
-  int edges = 0;
-  int weight = 0;
-  string fromVertex;
-  string toVertex;
-  myfile >> edges;
-  for (int i = 0; i < edges; ++i) {
-    myfile >> fromVertex >> toVertex >> weight;
-    connect(fromVertex, toVertex, weight);
-  }
+  ReadOptions options;
+  options.header = kHeaderCount;
+  options.comments = false;
+  ReadResult result = readStream(myfile, options);
   myfile.close();
+  if (!result.ok) {
+    cerr << filename << ":" << result.line << ": " << result.error << endl;
+  }
+  return result.ok;
+}
+
+// read edges from an input stream
+ReadResult Graph::readStream(istream &in, const ReadOptions &options) {
+  GRAPH_TIME(kOpReadStream);
+  EdgeReader reader(in, options.blockSize);
+  return readEdges(reader, options);
+}
+
+// read edges from a file descriptor
+ReadResult Graph::readFd(int fd, const ReadOptions &options) {
+  GRAPH_TIME(kOpReadFd);
+  EdgeReader reader(fd, options.blockSize);
+  return readEdges(reader, options);
+}
+
+/* readEdges connects the edges of reader one batch at a time, so only one
+ * block and one batch are held besides the graph
+ * @param reader is the input, options are the read settings
+ */
+ReadResult Graph::readEdges(EdgeReader &reader, const ReadOptions &options) {
+  return readEdgeList(reader, options,
+                      [this](vector<EdgeRecord> &batch, ReadResult &result) {
+                        applyBatch(batch, result);
+                      });
+}
+
+// applyBatch connects every edge of batch and empties it
+void Graph::applyBatch(vector<EdgeRecord> &batch, ReadResult &result) {
+  for (auto &record : batch) {
+    if (connect(record.from, record.to, record.weight)) {
+      result.edgesAdded++;
+    }
+  }
+  batch.clear();
+}
+
+/* memoryUsage estimates the heap bytes used by the graph: one allocation per
+ * vertex and per stored edge, the pointer vectors, out-of-line labels, the
+ * label index, whose nodes hold a copy of the label and its hash, and the
+ * change log
+ */
+MemoryUsage Graph::memoryUsage() const {
+  MemoryUsage usage;
+  size_t allocations = vertices.empty() ? 0 : 1;
+  usage.vertices = vertices.capacity() * sizeof(Vertex *) +
+                   vertices.size() * sizeof(Vertex);
+  allocations += vertices.size();
+  for (auto &v : vertices) {
+    usage.edges += v->neighbors.capacity() * sizeof(Edge *) +
+                   v->neighbors.size() * sizeof(Edge);
+    allocations += v->neighbors.size() + (v->neighbors.capacity() > 0 ? 1 : 0);
+    size_t labelBytes = MemoryUsage::stringHeapBytes(v->label);
+    usage.labels += labelBytes;
+    allocations += labelBytes > 0 ? 1 : 0;
+  }
+  usage.index = index.bucket_count() * sizeof(void *);
+  allocations += index.bucket_count() > 1 ? 1 : 0;
+  for (auto &entry : index) {
+    usage.index += sizeof(void *) + sizeof(entry) + sizeof(size_t) +
+                   MemoryUsage::stringHeapBytes(entry.first);
+    allocations += MemoryUsage::stringHeapBytes(entry.first) > 0 ? 2 : 1;
+  }
+  // a deque allocates its entries in blocks of 512 bytes
+  usage.changeLog = changes.size() * sizeof(pair<unsigned long, string>);
+  allocations += usage.changeLog / 512 + (changes.empty() ? 0 : 1);
+  for (auto &change : changes) {
+    size_t labelBytes = MemoryUsage::stringHeapBytes(change.second);
+    usage.changeLog += labelBytes;
+    allocations += labelBytes > 0 ? 1 : 0;
+  }
+  usage.overhead = allocations * MemoryUsage::kAllocOverhead;
+  return usage;
+}
+
+// version returns the number of changes made to the graph
+unsigned long Graph::version() const { return currentVersion; }
+
+/* changedSince appends the vertices changed after version since to labels,
+ * a vertex may be listed more than once
+ * @return false if the oldest of those changes was already dropped
+ */
+bool Graph::changedSince(unsigned long since, vector<string> &labels) const {
+  if (since >= currentVersion) {
+    return true;
+  }
+  if (since < forgotten) {
+    return false;
+  }
+  for (auto it = changes.rbegin(); it != changes.rend() && it->first > since;
+       ++it) {
+    labels.push_back(it->second);
+  }
   return true;
 }
+
+// recordChange bumps the version and logs label as changed
+void Graph::recordChange(const string &label) {
+  currentVersion++;
+  if (changes.size() == kMaxChanges) {
+    forgotten = changes.front().first;
+    changes.pop_front();
+  }
+  changes.emplace_back(currentVersion, label);
+}
+
+// snapshot of the operation counters, zero when not instrumented
+GraphStats Graph::getStats() const {
+  return counters ? counters->snapshot() : GraphStats();
+}
+
+// set all operation counters back to zero
+void Graph::resetStats() {
+  if (counters) {
+    counters->reset();
+  }
+}
@@ -9,13 +9,21 @@
 #define GRAPH_H
 
 #include "edge.h"
+#include "edgereader.h"
+#include "graphstats.h"
+#include "memoryusage.h"
 #include "vertex.h"
+#include <deque>
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 
 using namespace std;
 
 class Graph {
+  friend class CompactGraph;
+
 public:
   // constructor, empty graph
   explicit Graph(bool directionalEdges = true);
@@ -72,6 +80,17 @@ public:
   // @return true if file successfully read
   bool readFile(const string &filename);
 
+  // Read "from to weight" lines from in, in blocks of options.blockSize
+  // edges are connected in batches, blank lines are skipped and so are
+  // lines starting with # unless options.comments is false, see HeaderMode
+  // for the optional edge count line
+  // on a parse error the edges before it stay in the graph
+  // @return result with ok false and the line number on error
+  ReadResult readStream(istream &in, const ReadOptions &options = ReadOptions());
+
+  // Read edges like readStream from an open file descriptor, e.g. a pipe
+  ReadResult readFd(int fd, const ReadOptions &options = ReadOptions());
+
   // depth-first traversal starting from given startLabel
   void dfs(const string &startLabel, void visit(const string &label));
 
@@ -87,8 +106,28 @@ public:
   pair<map<string, int>, map<string, string> >
   dijkstra(const string &startLabel) const;
 
+  // @return snapshot of the operation counters
+  // all counters are zero unless compiled with -DGRAPH_INSTRUMENT
+  GraphStats getStats() const;
+
+  // set all operation counters back to zero
+  void resetStats();
+
+  // @return estimated heap bytes used by this graph, by category
+  MemoryUsage memoryUsage() const;
+
+  // @return a counter that grows with every successful add, connect and
+  // disconnect
+  unsigned long version() const;
+
+  // collect the vertices added or whose outgoing edges changed after since,
+  // results of searches that never reached one of them are still valid
+  // @return false if changes that old are no longer recorded
+  bool changedSince(unsigned long since, vector<string> &labels) const;
 
 private:
+  // most recent changes kept for changedSince
+  static const size_t kMaxChanges = 1024;
 
   bool directionalEdges;
 
@@ -98,11 +137,32 @@ private:
 
   vector<Vertex*> vertices;
 
+  // label to vertex, so find does not scan every vertex
+  unordered_map<string, Vertex *> index;
+
+  unsigned long currentVersion;
+
+  // version after each change and the vertex whose edges it changed, oldest
+  // first, at most kMaxChanges entries
+  deque<pair<unsigned long, string> > changes;
+
+  // newest version whose change was dropped from changes, 0 if none
+  unsigned long forgotten;
+
+  // only allocated when graph.cpp is compiled with -DGRAPH_INSTRUMENT
+  unique_ptr<GraphCounters> counters;
+
   bool find (const string &label, Vertex *&V) const;
 
+  ReadResult readEdges(EdgeReader &reader, const ReadOptions &options);
+
+  void applyBatch(vector<EdgeRecord> &batch, ReadResult &result);
+
+  void recordChange(const string &label);
+
   void dfsHelper(Vertex *vert, void visit(const string &label));
   
-  static vector<Edge *>dijakstraNeighborHelper(vector<Vertex *> visitedArray);
+  vector<Edge *>dijakstraNeighborHelper(vector<Vertex *> visitedArray) const;
 
   static Edge *dijakstraDistanceHelper(vector<Edge *> smallestEdge, map<string, int> weights);
 
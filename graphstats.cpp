@@ -0,0 +1,76 @@
+/* @file graphstats.cpp
+ * @brief The following code gives the implementations of the graph
+ * instrumentation counters.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "graphstats.h"
+#include <sstream>
+
+using namespace std;
+
+// set every counter back to zero
+void GraphStats::reset() { *this = GraphStats(); }
+
+// name used for each operation in the JSON output
+const char *GraphStats::opName(GraphOp op) {
+  static const char *names[kOpCount] = {
+      "add",        "contains", "connect", "disconnect",
+      "vertexDegree", "getEdgesAsString", "readFile", "readStream",
+      "readFd",     "dfs",      "bfs",     "dijkstra"};
+  return names[op];
+}
+
+// set every counter back to zero
+void GraphCounters::reset() {
+  findCalls = 0;
+  edgesScanned = 0;
+  edgesRelaxed = 0;
+  allocations = 0;
+  allocatedBytes = 0;
+  mapInserts = 0;
+  for (int i = 0; i < kOpCount; i++) {
+    calls[i] = 0;
+    cycles[i] = 0;
+  }
+}
+
+// snapshot copies the current values, counters still being updated by
+// other threads may be a few increments apart
+GraphStats GraphCounters::snapshot() const {
+  GraphStats stats;
+  stats.findCalls = findCalls;
+  stats.edgesScanned = edgesScanned;
+  stats.edgesRelaxed = edgesRelaxed;
+  stats.allocations = allocations;
+  stats.allocatedBytes = allocatedBytes;
+  stats.mapInserts = mapInserts;
+  for (int i = 0; i < kOpCount; i++) {
+    stats.calls[i] = calls[i];
+    stats.cycles[i] = cycles[i];
+  }
+  return stats;
+}
+
+/* toJson writes every counter as a single line JSON object, e.g.
+ * {"findCalls":3,...,"ops":{"add":{"calls":1,"cycles":120},...}}
+ */
+string GraphStats::toJson() const {
+  stringstream out;
+  out << "{\"findCalls\":" << findCalls
+      << ",\"edgesScanned\":" << edgesScanned
+      << ",\"edgesRelaxed\":" << edgesRelaxed
+      << ",\"allocations\":" << allocations
+      << ",\"allocatedBytes\":" << allocatedBytes
+      << ",\"mapInserts\":" << mapInserts << ",\"ops\":{";
+  for (int i = 0; i < kOpCount; i++) {
+    if (i > 0) {
+      out << ",";
+    }
+    out << "\"" << opName(static_cast<GraphOp>(i)) << "\":{\"calls\":"
+        << calls[i] << ",\"cycles\":" << cycles[i] << "}";
+  }
+  out << "}}";
+  return out.str();
+}
@@ -0,0 +1,144 @@
+/* @file graphstats.h
+ * @brief The following code gives the declarations of the optional
+ * instrumentation layer for the graph class. Counters are only collected
+ * when graph.cpp is compiled with -DGRAPH_INSTRUMENT, otherwise the
+ * GRAPH_COUNT and GRAPH_TIME macros expand to nothing. The Graph layout is
+ * the same either way, so other files may be built without the flag.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#ifndef GRAPHSTATS_H
+#define GRAPHSTATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace std;
+
+// public graph operations that are timed
+enum GraphOp {
+  kOpAdd,
+  kOpContains,
+  kOpConnect,
+  kOpDisconnect,
+  kOpVertexDegree,
+  kOpEdgesAsString,
+  kOpReadFile,
+  kOpReadStream,
+  kOpReadFd,
+  kOpDfs,
+  kOpBfs,
+  kOpDijkstra,
+  kOpCount
+};
+
+// snapshot of the graph counters, all zero when instrumentation is disabled
+struct GraphStats {
+  // label lookups, each one probe of the label index
+  uint64_t findCalls = 0;
+
+  // neighbor list entries examined and edges used to extend a path
+  uint64_t edgesScanned = 0;
+  uint64_t edgesRelaxed = 0;
+
+  // vertex and edge allocations done by the graph
+  uint64_t allocations = 0;
+  uint64_t allocatedBytes = 0;
+
+  // entries inserted into result maps
+  uint64_t mapInserts = 0;
+
+  // number of calls and elapsed cycles for each public operation
+  uint64_t calls[kOpCount] = {};
+  uint64_t cycles[kOpCount] = {};
+
+  // set every counter back to zero
+  void reset();
+
+  // @return the counters as a single line JSON object
+  string toJson() const;
+
+  // @return name used for op in the JSON output
+  static const char *opName(GraphOp op);
+};
+
+/* live counters of one graph, kept outside the Graph object so its layout
+ * does not depend on GRAPH_INSTRUMENT; relaxed atomics, because const
+ * queries may run on several threads at once
+ */
+struct GraphCounters {
+  GraphCounters() { reset(); }
+
+  GraphCounters(const GraphCounters &other) = delete;
+
+  GraphCounters &operator=(const GraphCounters &other) = delete;
+
+  // add n to counter
+  static void add(atomic<uint64_t> &counter, uint64_t n) {
+    counter.fetch_add(n, memory_order_relaxed);
+  }
+
+  // set every counter back to zero
+  void reset();
+
+  // @return the current values
+  GraphStats snapshot() const;
+
+  atomic<uint64_t> findCalls;
+  atomic<uint64_t> edgesScanned;
+  atomic<uint64_t> edgesRelaxed;
+  atomic<uint64_t> allocations;
+  atomic<uint64_t> allocatedBytes;
+  atomic<uint64_t> mapInserts;
+  atomic<uint64_t> calls[kOpCount];
+  atomic<uint64_t> cycles[kOpCount];
+};
+
+// @return a cheap monotonic timestamp, the TSC on x86 and nanoseconds elsewhere
+inline uint64_t graphCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return chrono::duration_cast<chrono::nanoseconds>(
+             chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+// adds the cycles spent in its scope to the given operation
+class GraphOpTimer {
+public:
+  GraphOpTimer(GraphCounters &counters, GraphOp op)
+      : counters(counters), op(op), start(graphCycles()) {}
+
+  GraphOpTimer(const GraphOpTimer &other) = delete;
+
+  GraphOpTimer &operator=(const GraphOpTimer &other) = delete;
+
+  ~GraphOpTimer() {
+    GraphCounters::add(counters.calls[op], 1);
+    GraphCounters::add(counters.cycles[op], graphCycles() - start);
+  }
+
+private:
+  GraphCounters &counters;
+  GraphOp op;
+  uint64_t start;
+};
+
+#ifdef GRAPH_INSTRUMENT
+#define GRAPH_COUNT(field, n) (GraphCounters::add(counters->field, (n)))
+#define GRAPH_TIME(op) GraphOpTimer graphOpTimer(*counters, op)
+#else
+#define GRAPH_COUNT(field, n) ((void)0)
+#define GRAPH_TIME(op) ((void)0)
+#endif
+
+#endif // GRAPHSTATS_H
@@ -5,11 +5,27 @@
  * @date 19 Oct 2019
  */
 
+#include "centrality.h"
+#include "compactgraph.h"
+#include "compressedgraph.h"
 #include "graph.h"
+#include "intersect.h"
+#include "neighborhood.h"
+#include "paths.h"
+#include "querycache.h"
+#include "queryexecutor.h"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <fcntl.h>
 #include <iostream>
+#include <random>
+#include <set>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unistd.h>
 
 using namespace std;
 
@@ -184,6 +200,18 @@ void testGraph0NotDirected() {
   assert(map2string(weights).empty() && "Dijkstra(C) weights");
   assert(map2string(previous).empty() && "Dijkstra(C) previous");
 
+  // reverse edges are kept sorted too
+  Graph u(false);
+  u.connect("b", "c", 1);
+  u.connect("a", "c", 2);
+  assert(u.getEdgesAsString("c") == "a(2),b(1)" && "sorted reverse edges");
+  assert(!u.connect("c", "a", 5) && "no parallel edges");
+  u.connect("d", "c", 3);
+  u.connect("0", "c", 4);
+  assert(u.getEdgesAsString("c") == "0(4),a(2),b(1),d(3)" &&
+         "reverse edges in label order, not in the order they were added");
+  assert(CompactGraph(u).getEdgesAsString("c") == u.getEdgesAsString("c"));
+
 //commented out because mstPrim is optional.
 //   globalSS.str("");
 // //   int mstLength = g.mstPrim("A", edgePrinter);
@@ -239,6 +267,737 @@ void testGraph1() {
          "Dijkstra(B) previous");
 }
 
+void testGraphStats() {
+  cout << "testGraphStats" << endl;
+  Graph g;
+  g.connect("A", "B", 1);
+  g.connect("B", "C", 3);
+  g.connect("A", "C", 8);
+  g.dijkstra("A");
+  GraphStats stats = g.getStats();
+  assert(stats.toJson().find("\"findCalls\":") != string::npos);
+#ifdef GRAPH_INSTRUMENT
+  assert(stats.calls[kOpConnect] == 3 && "three connect calls");
+  assert(stats.calls[kOpDijkstra] == 1 && "one dijkstra call");
+  stringstream edges("C D 1\n");
+  g.readStream(edges);
+  assert(g.getStats().calls[kOpReadStream] == 1 && "one readStream call");
+  assert(stats.allocations == 6 && "three vertices and three edges");
+  assert(stats.edgesRelaxed == 2 && "B and C reached");
+  assert(stats.findCalls > 0);
+  g.resetStats();
+  assert(g.getStats().findCalls == 0 && "counters reset");
+
+  // const queries from several threads lose no counts
+  vector<thread> readers;
+  for (int t = 0; t < 4; t++) {
+    readers.emplace_back([&g]() {
+      for (int i = 0; i < 1000; i++) {
+        g.contains("B");
+      }
+    });
+  }
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  assert(g.getStats().findCalls == 4000 && g.getStats().calls[kOpContains] == 4000);
+#else
+  assert(stats.findCalls == 0 && stats.calls[kOpConnect] == 0 &&
+         "counters compiled out");
+#endif
+}
+
+void testCompactGraph() {
+  cout << "testCompactGraph" << endl;
+  const char *files[] = {"graph0.txt", "graph1.txt", "graph2.txt",
+                         "graph3.txt", "graph4.txt"};
+  for (auto &file : files) {
+    for (bool isDirectional : {true, false}) {
+      Graph g(isDirectional);
+      if (!g.readFile(file)) {
+        return;
+      }
+      CompactGraph cg(g);
+      CompactGraph labelOrder(g);
+      // every numbering gives the same results, ties included
+      for (VertexOrder order :
+           {kOrderLabel, kOrderDegree, kOrderBfs, kOrderRcm, kOrderLabel}) {
+        cg.reorder(order);
+        assert(cg.verticesSize() == g.verticesSize() && "same vertices");
+        assert(cg.edgesSize() == g.edgesSize() && "same edges");
+        assert(!cg.contains("xxx") && cg.vertexDegree("xxx") == -1);
+        assert(cg.getEdgesAsString("xxx").empty());
+        for (char c = 'A'; c <= 'Z'; c++) {
+          string label(1, c);
+          assert(cg.contains(label) == g.contains(label));
+          assert(cg.vertexDegree(label) == g.vertexDegree(label));
+          assert(cg.getEdgesAsString(label) == g.getEdgesAsString(label));
+
+          globalSS.str("");
+          g.dfs(label, vertexPrinter);
+          string expected = globalSS.str();
+          globalSS.str("");
+          cg.dfs(label, vertexPrinter);
+          assert(globalSS.str() == expected && "compact dfs");
+
+          globalSS.str("");
+          g.bfs(label, vertexPrinter);
+          expected = globalSS.str();
+          globalSS.str("");
+          cg.bfs(label, vertexPrinter);
+          assert(globalSS.str() == expected && "compact bfs");
+          assert(cg.dijkstra(label) == labelOrder.dijkstra(label) &&
+                 "ties settle in label order");
+
+          // directed graph0 and graph1 have unique shortest paths
+          if (isDirectional &&
+              (string(file) == "graph0.txt" || string(file) == "graph1.txt")) {
+            assert(cg.dijkstra(label) == g.dijkstra(label) && "compact dijkstra");
+          } else {
+            assert(cg.dijkstra(label).first == g.dijkstra(label).first);
+          }
+        }
+      }
+      assert(cg.memoryUsage().total() < g.memoryUsage().total() &&
+             "compact layout is smaller");
+    }
+  }
+
+  // two equal paths to T, the one through the smaller label wins
+  Graph tie;
+  tie.connect("S", "A", 1);
+  tie.connect("S", "B", 1);
+  tie.connect("A", "T", 1);
+  tie.connect("B", "T", 1);
+  tie.connect("Z", "A", 0);
+  CompactGraph tieGraph(tie);
+  for (VertexOrder order : {kOrderLabel, kOrderDegree, kOrderBfs, kOrderRcm}) {
+    tieGraph.reorder(order);
+    assert(tieGraph.dijkstra("S").second["T"] == "A" && "tie in any order");
+    assert(CompressedGraph(tieGraph).dijkstra("S").second["T"] == "A");
+  }
+
+  // callers may bring their own scratch, threads sharing the graph's get one
+  Graph shared;
+  if (shared.readFile("graph1.txt")) {
+    CompactGraph sg(shared);
+    SearchScratch own;
+    auto expected = shared.dijkstra("A");
+    assert(sg.dijkstra("A", own) == expected && "caller scratch");
+    vector<thread> searches;
+    for (int t = 0; t < 4; t++) {
+      searches.emplace_back([&sg, &expected]() {
+        for (int i = 0; i < 50; i++) {
+          assert(sg.dijkstra("A") == expected);
+        }
+      });
+    }
+    for (auto &search : searches) {
+      search.join();
+    }
+  }
+
+  // built from the edge list without a Graph, repeats and loops included
+  mt19937 rng(3);
+  for (bool isDirectional : {true, false}) {
+    stringstream edges;
+    for (int i = 0; i < 400; i++) {
+      edges << static_cast<char>('A' + rng() % 26) << " "
+            << static_cast<char>('A' + rng() % 26) << " " << rng() % 9 << "\n";
+    }
+    Graph g(isDirectional);
+    ReadResult expected = g.readStream(edges);
+    edges.clear();
+    edges.seekg(0);
+    EdgeReader reader(edges, 64);
+    ReadResult result;
+    CompactGraph cg(reader, result, isDirectional);
+    assert(result.ok && result.edgesRead == expected.edgesRead);
+    assert(result.edgesAdded == expected.edgesAdded);
+    assert(cg.verticesSize() == g.verticesSize());
+    assert(cg.edgesSize() == g.edgesSize());
+    for (char c = 'A'; c <= 'Z'; c++) {
+      string label(1, c);
+      assert(cg.getEdgesAsString(label) == g.getEdgesAsString(label));
+      assert(cg.dijkstra(label).first == g.dijkstra(label).first);
+    }
+  }
+  stringstream bad("A B 1\nB C x\nC D 1\n");
+  EdgeReader reader(bad, 1 << 10);
+  ReadResult result;
+  CompactGraph partial(reader, result);
+  assert(!result.ok && result.line == 2 && partial.edgesSize() == 1);
+}
+
+void testCompressedGraph() {
+  cout << "testCompressedGraph" << endl;
+  const char *files[] = {"graph0.txt", "graph1.txt", "graph2.txt",
+                         "graph3.txt", "graph4.txt"};
+  for (auto &file : files) {
+    Graph g(false);
+    if (!g.readFile(file)) {
+      return;
+    }
+    CompactGraph cg(g);
+    // rows of a reordered graph are not sorted by id, gaps can be negative
+    cg.reorder(kOrderRcm);
+    CompressedGraph zg(cg);
+    assert(zg.verticesSize() == cg.verticesSize() && "same vertices");
+    assert(zg.edgesSize() == cg.edgesSize() && "same edges");
+    assert(!zg.contains("xxx") && zg.vertexDegree("xxx") == -1);
+    for (char c = 'A'; c <= 'Z'; c++) {
+      string label(1, c);
+      assert(zg.contains(label) == cg.contains(label));
+      assert(zg.vertexDegree(label) == cg.vertexDegree(label));
+      assert(zg.getEdgesAsString(label) == cg.getEdgesAsString(label));
+
+      globalSS.str("");
+      cg.dfs(label, vertexPrinter);
+      string expected = globalSS.str();
+      globalSS.str("");
+      zg.dfs(label, vertexPrinter);
+      assert(globalSS.str() == expected && "compressed dfs");
+
+      globalSS.str("");
+      cg.bfs(label, vertexPrinter);
+      expected = globalSS.str();
+      globalSS.str("");
+      zg.bfs(label, vertexPrinter);
+      assert(globalSS.str() == expected && "compressed bfs");
+
+      assert(zg.dijkstra(label) == cg.dijkstra(label) && "compressed dijkstra");
+    }
+  }
+
+  // weights of graph2 and graph3 are all 0 and take no space
+  Graph zero;
+  zero.readFile("graph3.txt");
+  CompactGraph zeroCompact(zero);
+  assert(CompressedGraph(zeroCompact).weightWidth() == 0);
+
+  // multi-byte gaps and wide, negative weights
+  Graph g;
+  for (int i = 0; i < 300; i++) {
+    g.add("v" + to_string(100 + i));
+  }
+  g.connect("v100", "v399", 70000);
+  g.connect("v100", "v250", -5);
+  g.connect("v399", "v101", 1);
+  CompactGraph cg(g);
+  CompressedGraph zg(cg);
+  assert(zg.weightWidth() == 4 && "70000 needs 4 bytes");
+  assert(zg.getEdgesAsString("v100") == "v250(-5),v399(70000)");
+  assert(zg.getEdgesAsString("v399") == "v101(1)");
+}
+
+void testIntersect() {
+  cout << "testIntersect" << endl;
+  mt19937 rng(7);
+  for (int round = 0; round < 200; round++) {
+    // sizes cover empty, SIMD tails and skewed lists
+    size_t na = rng() % 40;
+    size_t nb = round % 4 == 0 ? rng() % 4000 : rng() % 40;
+    uint32_t range = 10 + rng() % 200;
+    set<uint32_t> sa;
+    set<uint32_t> sb;
+    while (sa.size() < min<size_t>(na, range)) {
+      sa.insert(rng() % range);
+    }
+    while (sb.size() < min<size_t>(nb, range * 20)) {
+      sb.insert(rng() % (range * 20));
+    }
+    vector<uint32_t> a(sa.begin(), sa.end());
+    vector<uint32_t> b(sb.begin(), sb.end());
+    vector<uint32_t> expected(min(a.size(), b.size()));
+    size_t n = intersectMerge(a.data(), a.size(), b.data(), b.size(),
+                              expected.data());
+    expected.resize(n);
+    size_t (*kernels[])(const uint32_t *, size_t, const uint32_t *, size_t,
+                        uint32_t *) = {intersectGalloping, intersectSimd,
+                                       intersect};
+    for (auto &kernel : kernels) {
+      vector<uint32_t> out(expected.size() + 8);
+      assert(kernel(a.data(), a.size(), b.data(), b.size(), nullptr) == n);
+      assert(kernel(a.data(), a.size(), b.data(), b.size(), out.data()) == n);
+      out.resize(n);
+      assert(out == expected && "kernel matches scalar merge");
+    }
+  }
+}
+
+void testNeighborhood() {
+  cout << "testNeighborhood" << endl;
+  Graph g4(false);
+  if (!g4.readFile("graph4.txt")) {
+    return;
+  }
+  NeighborhoodAnalytics a4(g4, 2);
+  // triangles ABE, ABH and EIJ
+  assert(a4.triangles() == 3 && "graph4 triangles");
+  assert(a4.triangles("A") == 2 && a4.triangles("J") == 1);
+  assert(a4.triangles("xxx") == -1 && a4.clusteringCoefficient("xxx") == -1);
+  assert((a4.commonNeighbors("A", "B") == vector<string>{"E", "H"}));
+  assert(a4.commonNeighbors("A", "xxx").empty());
+  // A has neighbors B E F H, 2 of their 6 pairs are connected
+  assert(fabs(a4.clusteringCoefficient("A") - 2.0 / 6) < 1e-9);
+  // N(A) = {B,E,F,H}, N(B) = {A,D,E,H}
+  assert(fabs(a4.jaccard("A", "B") - 2.0 / 6) < 1e-9);
+
+  // random graph checked against brute force on the edge set
+  mt19937 rng(11);
+  Graph g(false);
+  set<pair<int, int>> edges;
+  const int n = 60;
+  for (int i = 0; i < 600; i++) {
+    int u = rng() % n;
+    int v = rng() % n;
+    if (u != v && g.connect(to_string(u), to_string(v), 1)) {
+      edges.emplace(u, v);
+      edges.emplace(v, u);
+    }
+  }
+  for (int threads : {1, 4}) {
+    NeighborhoodAnalytics a(g, threads);
+    long long total = 0;
+    for (int u = 0; u < n; u++) {
+      if (!g.contains(to_string(u))) {
+        continue;
+      }
+      long long through = 0;
+      for (int v = 0; v < n; v++) {
+        for (int w = v + 1; w < n; w++) {
+          if (edges.count({u, v}) && edges.count({u, w}) &&
+              edges.count({v, w})) {
+            through++;
+          }
+        }
+      }
+      assert(a.triangles(to_string(u)) == through && "per vertex triangles");
+      total += through;
+    }
+    assert(a.triangles() == total / 3 && "global triangles");
+    vector<string> common;
+    for (int w = 0; w < n; w++) {
+      if (edges.count({3, w}) && edges.count({4, w})) {
+        common.push_back(to_string(w));
+      }
+    }
+    sort(common.begin(), common.end());
+    assert(a.commonNeighbors("3", "4") == common && "common neighbors");
+  }
+}
+
+void testCentrality() {
+  cout << "testCentrality" << endl;
+  Graph g;
+  if (!g.readFile("graph1.txt")) {
+    return;
+  }
+  CentralityAnalytics c(g, 4);
+  assert(c.outDegree("A") == 2 && c.inDegree("A") == 0);
+  assert(c.inDegree("G") == 2 && c.outDegree("G") == 0);
+  assert(c.inDegree("xxx") == -1 && c.outDegree("xxx") == -1);
+  assert(map2string(c.inDegrees()) ==
+         "[A:0][B:1][C:1][D:1][E:1][F:1][G:2][H:1][X:0][Y:1]");
+  assert(c.outDegrees().at("A") == g.vertexDegree("A"));
+
+  // ranks sum to 1 and do not depend on the number of threads
+  PageRankResult ranks = c.pageRank();
+  CentralityAnalytics serial(g, 1);
+  PageRankResult serialRanks = serial.pageRank();
+  double sum = 0;
+  for (auto &r : ranks.ranks) {
+    sum += r.second;
+    assert(fabs(r.second - serialRanks.ranks.at(r.first)) < 1e-12);
+  }
+  assert(fabs(sum - 1) < 1e-9 && "ranks sum to 1");
+  assert(ranks.delta < 1e-9 && ranks.iterations < 100 && "converged");
+  assert(ranks.ranks.at("G") > ranks.ranks.at("A") && "G has most links in");
+
+  PageRankOptions once;
+  once.maxIterations = 1;
+  assert(c.pageRank(once).iterations == 1 && "iteration cap");
+
+  // nothing reachable from A jumps to X or Y
+  PageRankResult fromA = c.personalizedPageRank({"A", "xxx"});
+  assert(fromA.ranks.at("X") == 0 && fromA.ranks.at("Y") == 0);
+  assert(fromA.ranks.at("A") > 0);
+  assert(c.personalizedPageRank({"xxx"}).ranks.empty());
+
+  // symmetric cycle, every vertex has the same rank
+  Graph cycle;
+  cycle.connect("A", "B");
+  cycle.connect("B", "C");
+  cycle.connect("C", "A");
+  for (auto &r : CentralityAnalytics(cycle).pageRank().ranks) {
+    assert(fabs(r.second - 1.0 / 3) < 1e-9 && "cycle ranks");
+  }
+
+  // B is on the shortest paths from A to C, D, E and F, H only on A to G
+  map<string, double> between = c.betweenness();
+  assert(between.at("B") == 4 && between.at("H") == 1);
+  assert(between.at("A") == 0 && between.at("G") == 0);
+  assert(c.betweenness(100) == between && "enough samples is exact");
+  assert(c.betweenness(3).size() == between.size());
+
+  Graph path(false);
+  path.connect("A", "B");
+  path.connect("B", "C");
+  map<string, double> middle = CentralityAnalytics(path).betweenness();
+  assert(middle.at("B") == 1 && middle.at("A") == 0 && "undirected path");
+}
+
+// global value for testing progress reports
+// NOLINTNEXTLINE
+vector<long long> globalProgress;
+
+void progressRecorder(long long edges, long long /*bytes*/) {
+  globalProgress.push_back(edges);
+}
+
+void testReadStream() {
+  cout << "testReadStream" << endl;
+  // no count, comments, CRLF, tabs and a last line without line break
+  stringstream noCount("# from to weight\r\nA B 1\r\n\nB\tC  3\n"
+                       "A C -8");
+  Graph g;
+  ReadResult result = g.readStream(noCount);
+  assert(result.ok && result.edgesRead == 3 && result.edgesAdded == 3);
+  assert(g.getEdgesAsString("A") == "B(1),C(-8)");
+  assert(g.getEdgesAsString("B") == "C(3)");
+
+  // auto uses the count and ignores the rest like readFile
+  stringstream counted("2\nA B 1\nB C 3\nnot an edge\n");
+  Graph g2;
+  result = g2.readStream(counted);
+  assert(result.ok && g2.edgesSize() == 2 && "stops at count");
+
+  // skip drops the count and reads every line
+  stringstream skipped("1\nA B 1\nB C 3\n");
+  ReadOptions skip;
+  skip.header = kHeaderSkip;
+  Graph g3;
+  assert(g3.readStream(skipped, skip).edgesRead == 2 && "count ignored");
+
+  // errors carry the line number
+  stringstream badWeight("2\nA B 1\nB C x\n");
+  Graph g4;
+  result = g4.readStream(badWeight);
+  assert(!result.ok && result.line == 3 && "bad weight on line 3");
+  assert(g4.edgesSize() == 1 && "edges before the error are kept");
+
+  stringstream missing("3\nA B 1\n\nB C 2\n");
+  result = Graph().readStream(missing);
+  assert(!result.ok && result.line == 4 && result.error.find("expected 3") == 0);
+
+  stringstream noHeader("A B 1\n");
+  ReadOptions countRequired;
+  countRequired.header = kHeaderCount;
+  result = Graph().readStream(noHeader, countRequired);
+  assert(!result.ok && result.line == 1 && "count required");
+
+  // # starts a comment, except where labels may start with it
+  stringstream hash("1\n#x B 3\n");
+  ReadOptions countOnly;
+  countOnly.header = kHeaderCount;
+  countOnly.comments = false;
+  Graph g7;
+  assert(g7.readStream(hash, countOnly).ok && g7.contains("#x"));
+  hash.clear();
+  hash.seekg(0);
+  assert(!Graph().readStream(hash).ok && "only comments after the count");
+
+  stringstream tooMany("A B 1 2\n");
+  assert(Graph().readStream(tooMany).line == 1 && "extra token");
+  stringstream overflow("A B 99999999999\n");
+  assert(!Graph().readStream(overflow).ok && "weight overflow");
+
+  // lines longer than the block, small batches and progress reports
+  string big;
+  for (int i = 0; i < 100; i++) {
+    big += "vertex" + to_string(i) + " vertex" + to_string(i + 1) + " " +
+           to_string(i) + "\n";
+  }
+  stringstream bigStream(big);
+  ReadOptions tiny;
+  tiny.header = kHeaderNone;
+  tiny.blockSize = 7;
+  tiny.batchSize = 16;
+  tiny.progress = progressRecorder;
+  globalProgress.clear();
+  Graph g5;
+  result = g5.readStream(bigStream, tiny);
+  assert(result.ok && result.edgesAdded == 100 && g5.verticesSize() == 101);
+  assert(result.bytesRead == static_cast<long long>(big.size()));
+  assert(globalProgress.size() == 7 && globalProgress.back() == 100);
+  assert(g5.getEdgesAsString("vertex42") == "vertex43(42)");
+
+  // file descriptors, e.g. pipes
+  int fd = open("graph1.txt", O_RDONLY);
+  if (fd >= 0) {
+    Graph g6;
+    result = g6.readFd(fd);
+    close(fd);
+    assert(result.ok && g6.edgesSize() == 9 && "graph1 through fd");
+  }
+}
+
+// cost of every loopless path from v to to, by brute force
+static void allPaths(const map<string, map<string, int>> &edges,
+                     const string &v, const string &to, int cost,
+                     set<string> &onPath, vector<int> &costs) {
+  if (v == to) {
+    costs.push_back(cost);
+    return;
+  }
+  auto it = edges.find(v);
+  if (it == edges.end()) {
+    return;
+  }
+  for (auto &e : it->second) {
+    if (onPath.insert(e.first).second) {
+      allPaths(edges, e.first, to, cost + e.second, onPath, costs);
+      onPath.erase(e.first);
+    }
+  }
+}
+
+void testPaths() {
+  cout << "testPaths" << endl;
+  Graph g;
+  if (!g.readFile("graph1.txt")) {
+    return;
+  }
+  CompactGraph cg(g);
+  PathFinder finder(cg);
+  vector<Path> paths = finder.kShortestPaths("A", "G", 5);
+  assert(paths.size() == 2 && "only two ways from A to G");
+  assert(paths[0].cost == 4 && (paths[0].vertices == vector<string>{"A", "H", "G"}));
+  assert(paths[1].cost == 6 && paths[1].vertices.size() == 7);
+  assert(finder.kShortestPaths("A", "X", 3).empty() && "X not reachable");
+  assert(finder.kShortestPaths("A", "xxx", 3).empty());
+  assert(finder.kShortestPaths("A", "G", 0).empty());
+
+  // stop once C is settled, H at 3 is never reached
+  assert(map2string(finder.boundedSearch("A", {"C", "xxx"}).first) ==
+         "[B:1][C:2]");
+  assert(map2string(finder.boundedSearch("A", {}, 3).first) ==
+         "[B:1][C:2][D:3][H:3]");
+  assert(finder.boundedSearch("A", {}) == cg.dijkstra("A") && "no limits");
+  assert(finder.boundedSearch("xxx", {}).first.empty());
+  PathFinder fromGraph(g);
+  assert(fromGraph.kShortestPaths("A", "G", 5).size() == 2 && "own snapshot");
+
+  // random graph, costs checked against every loopless path
+  mt19937 rng(5);
+  for (bool isDirectional : {true, false}) {
+    Graph r(isDirectional);
+    map<string, map<string, int>> edges;
+    for (int i = 0; i < 40; i++) {
+      string u(1, static_cast<char>('a' + rng() % 9));
+      string v(1, static_cast<char>('a' + rng() % 9));
+      int w = 1 + rng() % 9;
+      if (r.connect(u, v, w)) {
+        edges[u][v] = w;
+        if (!isDirectional) {
+          edges[v][u] = w;
+        }
+      }
+    }
+    CompactGraph rc(r);
+    rc.reorder(kOrderRcm);
+    PathFinder rf(rc);
+    for (char to = 'b'; to <= 'i'; to++) {
+      vector<int> costs;
+      set<string> onPath = {"a"};
+      allPaths(edges, "a", string(1, to), 0, onPath, costs);
+      sort(costs.begin(), costs.end());
+      costs.resize(min<size_t>(costs.size(), 12));
+      vector<Path> found = rf.kShortestPaths("a", string(1, to), 12);
+      assert(found.size() == costs.size() && "as many paths as exist");
+      set<vector<string>> distinct;
+      for (size_t i = 0; i < found.size(); i++) {
+        assert(found[i].cost == costs[i] && "k-th cost");
+        set<string> unique(found[i].vertices.begin(), found[i].vertices.end());
+        assert(unique.size() == found[i].vertices.size() && "loopless");
+        distinct.insert(found[i].vertices);
+      }
+      assert(distinct.size() == found.size() && "paths are distinct");
+    }
+  }
+}
+
+void testQueryCache() {
+  cout << "testQueryCache" << endl;
+  Graph g;
+  if (!g.readFile("graph1.txt")) {
+    return;
+  }
+  QueryCache cache(g);
+  auto a = cache.dijkstra("A");
+  assert(*a == g.dijkstra("A") && cache.stats().misses == 1);
+  assert(cache.dijkstra("A") == a && cache.stats().hits == 1 && "same result");
+  globalSS.str("");
+  g.bfs("A", vertexPrinter);
+  string order;
+  for (auto &label : *cache.bfs("A")) {
+    order += label;
+  }
+  assert(order == globalSS.str());
+  cache.dijkstra("X");
+  assert(cache.stats().entries == 3 && cache.stats().bytes > 0);
+
+  // only results that reached the changed vertex are dropped
+  unsigned long version = g.version();
+  assert(g.connect("X", "Z", 2) && g.version() > version);
+  assert(cache.dijkstra("A") == a && cache.stats().invalidations == 1);
+  assert(map2string(cache.dijkstra("X")->first) == "[Y:10][Z:2]");
+  // searches from a vertex that did not exist yet
+  assert(cache.bfs("W")->empty() && cache.bfs("Q")->empty());
+  assert(g.add("W") && cache.dijkstra("A") == a && "W is not reached");
+  assert((*cache.bfs("W") == vector<string>{"W"}) && "new vertex");
+  assert(g.connect("W", "Q", 1));
+  assert((*cache.bfs("Q") == vector<string>{"Q"}) && "new edge target");
+  assert((*cache.bfs("W") == vector<string>{"W", "Q"}));
+  assert(!g.connect("A", "B", 5) && cache.dijkstra("A") == a);
+  assert(g.disconnect("A", "H") && cache.dijkstra("A") != a);
+  assert(*cache.dijkstra("A") == g.dijkstra("A"));
+  assert(cache.bfs("A")->size() == 7 && "H is no longer reached");
+  cache.invalidate("G");
+  assert(cache.stats().entries == 3 && "only X, W and Q are left");
+
+  // lost change log drops everything
+  CacheStats before = cache.stats();
+  for (int i = 0; i < 1100; i++) {
+    g.connect("p" + to_string(i), "q", 1);
+  }
+  cache.dijkstra("X");
+  assert(cache.stats().misses == before.misses + 1);
+  assert(cache.stats().invalidations == before.invalidations + 3);
+  MemoryUsage usage = g.memoryUsage();
+  assert(usage.changeLog >= 1024 * sizeof(pair<unsigned long, string>) &&
+         Graph().memoryUsage().changeLog == 0 && "full change log counted");
+
+  // least recently used result goes first
+  Graph h;
+  h.readFile("graph1.txt");
+  QueryCache sizing(h);
+  sizing.dijkstra("A");
+  sizing.dijkstra("X");
+  QueryCache small(h, sizing.stats().bytes);
+  small.dijkstra("A");
+  small.dijkstra("X");
+  small.dijkstra("A");
+  small.dijkstra("Y");
+  assert(small.stats().evictions == 1 && small.stats().entries == 2);
+  small.dijkstra("A");
+  assert(small.stats().hits == 2 && "A was kept");
+  small.dijkstra("X");
+  assert(small.stats().misses == 4 && "X was evicted");
+  QueryCache none(h, 1);
+  none.dijkstra("A");
+  none.dijkstra("A");
+  assert(none.stats().hits == 0 && none.stats().entries == 0);
+
+  // concurrent readers see the same results as the graph
+  map<string, map<string, int>> expected;
+  for (char c = 'A'; c <= 'H'; c++) {
+    expected[string(1, c)] = h.dijkstra(string(1, c)).first;
+  }
+  QueryCache shared(h);
+  vector<thread> readers;
+  for (int t = 0; t < 4; t++) {
+    readers.emplace_back([&shared, &expected, t]() {
+      for (int i = 0; i < 200; i++) {
+        string label(1, static_cast<char>('A' + (i + t) % 8));
+        assert(shared.dijkstra(label)->first == expected[label]);
+        assert(shared.bfs(label)->front() == label);
+      }
+    });
+  }
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  assert(shared.stats().misses == 16 && shared.stats().hits == 1584);
+}
+
+void testQueryExecutor() {
+  cout << "testQueryExecutor" << endl;
+  for (bool isDirectional : {true, false}) {
+    Graph g(isDirectional);
+    mt19937 rng(7);
+    for (int i = 0; i < 300; i++) {
+      g.connect(to_string(rng() % 60), to_string(rng() % 60), rng() % 20);
+    }
+    CompactGraph cg(g);
+    vector<Query> batch;
+    for (int i = 0; i < 500; i++) {
+      Query query;
+      query.kind = static_cast<QueryKind>(rng() % 3);
+      query.label = i % 50 == 0 ? "xxx" : to_string(rng() % 60);
+      batch.push_back(query);
+    }
+
+    QueryExecutor executor(g, 3);
+    assert(executor.threads() == 3);
+    vector<QueryResult> results = executor.submit(batch).get();
+    assert(results.size() == batch.size());
+    for (size_t i = 0; i < batch.size(); i++) {
+      const string &label = batch[i].label;
+      if (batch[i].kind == kQueryDijkstra) {
+        assert(results[i].paths == cg.dijkstra(label) && "same as CompactGraph");
+        assert(results[i].paths.first == g.dijkstra(label).first);
+      } else if (batch[i].kind == kQueryBfs) {
+        globalSS.str("");
+        g.bfs(label, vertexPrinter);
+        string order;
+        for (auto &v : results[i].order) {
+          order += v;
+        }
+        assert(order == globalSS.str() && "same order as Graph::bfs");
+      } else {
+        assert(results[i].edges == g.getEdgesAsString(label));
+      }
+      assert(results[i].latency >= 0);
+    }
+    ExecutorStats stats = executor.stats();
+    assert(stats.batches == 1 && stats.queries == 500);
+    assert(stats.computed <= 3 * 61 && "repeats are answered once");
+
+    // batches from many threads, answered through callbacks
+    atomic<int> answered(0);
+    vector<thread> clients;
+    for (int t = 0; t < 4; t++) {
+      clients.emplace_back([&executor, &batch, &results, &answered]() {
+        for (int i = 0; i < 20; i++) {
+          vector<Query> part(batch.begin() + i * 20, batch.begin() + i * 20 + 25);
+          executor.submit(part, [&results, &answered, i](vector<QueryResult> &r) {
+            for (size_t j = 0; j < r.size(); j++) {
+              assert(r[j].paths == results[i * 20 + j].paths);
+              assert(r[j].order == results[i * 20 + j].order);
+              assert(r[j].edges == results[i * 20 + j].edges);
+            }
+            answered++;
+          });
+        }
+      });
+    }
+    for (auto &client : clients) {
+      client.join();
+    }
+    assert(executor.submit(vector<Query>()).get().empty());
+    bool called = false;
+    executor.submit(vector<Query>(), [&called](vector<QueryResult> &r) {
+      called = r.empty();
+    });
+    assert(called && "empty batch completes right away");
+    while (answered < 80) {
+      this_thread::yield();
+    }
+    assert(executor.stats().batches == 83);
+  }
+}
+
 void testAll() {
   testGraphBasic();
   testGraph0DFS();
@@ -246,4 +1005,14 @@ void testAll() {
   testGraph0Dijkstra();
   testGraph0NotDirected();
   testGraph1();
+  testGraphStats();
+  testCompactGraph();
+  testCompressedGraph();
+  testIntersect();
+  testNeighborhood();
+  testCentrality();
+  testReadStream();
+  testPaths();
+  testQueryCache();
+  testQueryExecutor();
 }
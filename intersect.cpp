@@ -0,0 +1,154 @@
+/* @file intersect.cpp
+ * @brief The following code gives the implementations of the intersection
+ * kernels for sorted vertex id arrays.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "intersect.h"
+#include <algorithm>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// size ratio above which galloping beats merging
+static const size_t kGallopRatio = 32;
+
+// intersectMerge walks both arrays once
+size_t intersectMerge(const uint32_t *a, size_t na, const uint32_t *b,
+                      size_t nb, uint32_t *out) {
+  size_t i = 0;
+  size_t j = 0;
+  size_t count = 0;
+  while (i < na && j < nb) {
+    if (a[i] < b[j]) {
+      i++;
+    } else if (b[j] < a[i]) {
+      j++;
+    } else {
+      if (out != nullptr) {
+        out[count] = a[i];
+      }
+      count++;
+      i++;
+      j++;
+    }
+  }
+  return count;
+}
+
+/* intersectGalloping doubles the step in b until it passes a[i], then binary
+ * searches that range, so the cost is O(na log(nb / na))
+ */
+size_t intersectGalloping(const uint32_t *a, size_t na, const uint32_t *b,
+                          size_t nb, uint32_t *out) {
+  size_t count = 0;
+  size_t lo = 0;
+  for (size_t i = 0; i < na && lo < nb; i++) {
+    uint32_t x = a[i];
+    size_t step = 1;
+    size_t hi = lo;
+    while (hi < nb && b[hi] < x) {
+      lo = hi + 1;
+      hi += step;
+      step *= 2;
+    }
+    hi = min(hi + 1, nb);
+    lo = lower_bound(b + lo, b + hi, x) - b;
+    if (lo < nb && b[lo] == x) {
+      if (out != nullptr) {
+        out[count] = x;
+      }
+      count++;
+      lo++;
+    }
+  }
+  return count;
+}
+
+#if defined(__AVX2__)
+#define INTERSECT_SIMD 1
+static const size_t kSimdWidth = 8;
+
+// @return bit k set when a[k] is equal to one of b[0] .. b[7]
+static inline unsigned blockMatch(const uint32_t *a, const uint32_t *b) {
+  const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+  __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a));
+  __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b));
+  __m256i match = _mm256_cmpeq_epi32(va, vb);
+  for (size_t r = 1; r < kSimdWidth; r++) {
+    vb = _mm256_permutevar8x32_epi32(vb, rotate);
+    match = _mm256_or_si256(match, _mm256_cmpeq_epi32(va, vb));
+  }
+  return _mm256_movemask_ps(_mm256_castsi256_ps(match));
+}
+#elif defined(__SSE2__)
+#define INTERSECT_SIMD 1
+static const size_t kSimdWidth = 4;
+
+// @return bit k set when a[k] is equal to one of b[0] .. b[3]
+static inline unsigned blockMatch(const uint32_t *a, const uint32_t *b) {
+  __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a));
+  __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b));
+  __m128i match = _mm_cmpeq_epi32(va, vb);
+  __m128i r1 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+  __m128i r2 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2));
+  __m128i r3 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3));
+  match = _mm_or_si128(match, _mm_cmpeq_epi32(va, r1));
+  match = _mm_or_si128(match, _mm_cmpeq_epi32(va, r2));
+  match = _mm_or_si128(match, _mm_cmpeq_epi32(va, r3));
+  return _mm_movemask_ps(_mm_castsi128_ps(match));
+}
+#endif
+
+/* intersectSimd compares a block of a against every rotation of a block of b,
+ * the mask tells which ids of the a block were found, then the block with the
+ * smaller last id is skipped; ids are unique so nothing is counted twice
+ */
+size_t intersectSimd(const uint32_t *a, size_t na, const uint32_t *b,
+                     size_t nb, uint32_t *out) {
+  size_t i = 0;
+  size_t j = 0;
+  size_t count = 0;
+#ifdef INTERSECT_SIMD
+  while (i + kSimdWidth <= na && j + kSimdWidth <= nb) {
+    unsigned mask = blockMatch(a + i, b + j);
+    if (out != nullptr) {
+      for (unsigned m = mask; m != 0; m &= m - 1) {
+        out[count++] = a[i + __builtin_ctz(m)];
+      }
+    } else {
+      count += __builtin_popcount(mask);
+    }
+    uint32_t lastA = a[i + kSimdWidth - 1];
+    uint32_t lastB = b[j + kSimdWidth - 1];
+    if (lastA <= lastB) {
+      i += kSimdWidth;
+    }
+    if (lastB <= lastA) {
+      j += kSimdWidth;
+    }
+  }
+#endif
+  return count + intersectMerge(a + i, na - i, b + j, nb - j,
+                                out == nullptr ? nullptr : out + count);
+}
+
+// intersect picks the kernel for the sizes of a and b
+size_t intersect(const uint32_t *a, size_t na, const uint32_t *b, size_t nb,
+                 uint32_t *out) {
+  if (na > nb) {
+    swap(a, b);
+    swap(na, nb);
+  }
+  if (na == 0) {
+    return 0;
+  }
+  if (nb / na >= kGallopRatio) {
+    return intersectGalloping(a, na, b, nb, out);
+  }
+  return intersectSimd(a, na, b, nb, out);
+}
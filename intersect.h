@@ -0,0 +1,33 @@
+/* @file intersect.h
+ * @brief The following code gives the declarations of the intersection
+ * kernels for sorted vertex id arrays. The arrays must be sorted and hold
+ * no duplicates. Every kernel writes the common ids, in sorted order, to out
+ * when out is not nullptr and returns how many ids are in common.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#ifndef INTERSECT_H
+#define INTERSECT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// scalar merge, the reference the other kernels are checked against
+size_t intersectMerge(const uint32_t *a, size_t na, const uint32_t *b,
+                      size_t nb, uint32_t *out);
+
+// binary search each id of a in b, for a much shorter than b
+size_t intersectGalloping(const uint32_t *a, size_t na, const uint32_t *b,
+                          size_t nb, uint32_t *out);
+
+// block merge comparing 8 (AVX2) or 4 (SSE2) ids of a with as many of b
+// falls back to intersectMerge when compiled without SSE2
+size_t intersectSimd(const uint32_t *a, size_t na, const uint32_t *b,
+                     size_t nb, uint32_t *out);
+
+// picks galloping for skewed sizes and the SIMD merge otherwise
+size_t intersect(const uint32_t *a, size_t na, const uint32_t *b, size_t nb,
+                 uint32_t *out);
+
+#endif // INTERSECT_H
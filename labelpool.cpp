@@ -0,0 +1,110 @@
+/* @file labelpool.cpp
+ * @brief The following code gives the implementations of the label pool.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "labelpool.h"
+#include "memoryusage.h"
+
+using namespace std;
+
+// reserve room for count labels with a total of chars characters
+void LabelPool::reserve(size_t count, size_t chars) {
+  pool.reserve(chars);
+  offsets.reserve(count + 1);
+}
+
+// add label as the next id
+void LabelPool::add(const string &label) {
+  pool += label;
+  offsets.push_back(pool.size());
+}
+
+// size returns the number of labels
+uint32_t LabelPool::size() const { return offsets.size() - 1; }
+
+/* find does a binary search over the label ordered ids
+ * @param label is the string being referenced, id is set when found
+ */
+bool LabelPool::find(const string &label, uint32_t &id) const {
+  uint32_t lo = 0;
+  uint32_t hi = size();
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2;
+    uint32_t k = byLabel(mid);
+    int c = pool.compare(offsets[k], offsets[k + 1] - offsets[k], label);
+    if (c == 0) {
+      id = k;
+      return true;
+    }
+    if (c < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return false;
+}
+
+// label returns a copy of the label of id
+string LabelPool::label(uint32_t id) const {
+  return pool.substr(offsets[id], offsets[id + 1] - offsets[id]);
+}
+
+// byLabel returns the id with the k-th smallest label
+uint32_t LabelPool::byLabel(uint32_t k) const {
+  return sorted.empty() ? k : sorted[k];
+}
+
+// rank returns the position of id in label order
+uint32_t LabelPool::rank(uint32_t id) const {
+  return ranks.empty() ? id : ranks[id];
+}
+
+/* permute rebuilds the pool in the new id order and keeps the ids sorted
+ * by label for find
+ * @param order lists the old ids in their new order
+ */
+void LabelPool::permute(const vector<uint32_t> &order) {
+  vector<uint32_t> newId(order.size());
+  for (uint32_t k = 0; k < order.size(); k++) {
+    newId[order[k]] = k;
+  }
+  vector<uint32_t> bySorted(order.size());
+  bool identity = true;
+  for (uint32_t k = 0; k < order.size(); k++) {
+    bySorted[k] = newId[byLabel(k)];
+    identity = identity && bySorted[k] == k;
+  }
+
+  string newPool;
+  newPool.reserve(pool.size());
+  vector<uint64_t> newOffsets(1, 0);
+  newOffsets.reserve(offsets.size());
+  for (auto &old : order) {
+    newPool.append(pool, offsets[old], offsets[old + 1] - offsets[old]);
+    newOffsets.push_back(newPool.size());
+  }
+  pool.swap(newPool);
+  offsets.swap(newOffsets);
+  if (identity) {
+    sorted.clear();
+    sorted.shrink_to_fit();
+    ranks.clear();
+    ranks.shrink_to_fit();
+  } else {
+    sorted.swap(bySorted);
+    ranks.resize(sorted.size());
+    for (uint32_t k = 0; k < sorted.size(); k++) {
+      ranks[sorted[k]] = k;
+    }
+  }
+}
+
+// memoryBytes returns the heap bytes of the characters, offsets and order
+size_t LabelPool::memoryBytes() const {
+  return MemoryUsage::stringHeapBytes(pool) +
+         offsets.capacity() * sizeof(uint64_t) +
+         (sorted.capacity() + ranks.capacity()) * sizeof(uint32_t);
+}
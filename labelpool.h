@@ -0,0 +1,64 @@
+/* @file labelpool.h
+ * @brief The following code gives the declarations of the label pool used by
+ * the read-only graphs. All labels are packed into one string, vertex ids
+ * are assigned in the order labels are added and labels must be added in
+ * sorted order so a label can be found by binary search. After permute the
+ * ids no longer follow label order and the search goes through a sorted
+ * list of ids instead, kept with its inverse so the rank of an id is one
+ * lookup.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#ifndef LABELPOOL_H
+#define LABELPOOL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class LabelPool {
+public:
+  // reserve room for count labels with a total of chars characters
+  void reserve(size_t count, size_t chars);
+
+  // add label as the next id, labels must be added in sorted order
+  void add(const string &label);
+
+  // @return number of labels
+  uint32_t size() const;
+
+  // @return true if label is found, id is set to its id
+  bool find(const string &label, uint32_t &id) const;
+
+  // @return a copy of the label of id
+  string label(uint32_t id) const;
+
+  // @return the id with the k-th smallest label
+  uint32_t byLabel(uint32_t k) const;
+
+  // @return k such that byLabel(k) == id
+  uint32_t rank(uint32_t id) const;
+
+  // renumber the labels, order[k] is the id that becomes id k
+  void permute(const vector<uint32_t> &order);
+
+  // @return heap bytes used by the pool
+  size_t memoryBytes() const;
+
+private:
+  // label of id is pool[offsets[id]] .. pool[offsets[id + 1]]
+  string pool;
+
+  vector<uint64_t> offsets = vector<uint64_t>(1, 0);
+
+  // ids in label order, empty while ids are in label order themselves
+  vector<uint32_t> sorted;
+
+  // rank of each id, the inverse of sorted and empty with it
+  vector<uint32_t> ranks;
+};
+
+#endif // LABELPOOL_H
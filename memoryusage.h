@@ -0,0 +1,55 @@
+/* @file memoryusage.h
+ * @brief The following code gives the declarations of the memory accounting
+ * report shared by Graph and CompactGraph.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#ifndef MEMORYUSAGE_H
+#define MEMORYUSAGE_H
+
+#include <cstddef>
+#include <string>
+
+using namespace std;
+
+// heap bytes used by a graph representation, split by category
+struct MemoryUsage {
+  // per-vertex records and the vertex table
+  size_t vertices = 0;
+
+  // adjacency: edge records, target ids, weights and offsets
+  size_t edges = 0;
+
+  // label characters stored outside the string objects
+  size_t labels = 0;
+
+  // lookup structures used to find a vertex by label
+  size_t index = 0;
+
+  // recent changes Graph keeps for changedSince, entries and their labels
+  size_t changeLog = 0;
+
+  // estimated allocator bookkeeping, kAllocOverhead bytes per allocation
+  size_t overhead = 0;
+
+  // estimated bookkeeping bytes malloc adds to every allocation
+  static const size_t kAllocOverhead = 2 * sizeof(void *);
+
+  // @return sum of all categories
+  size_t total() const {
+    return vertices + edges + labels + index + changeLog + overhead;
+  }
+
+  // @return heap bytes owned by s, 0 when it fits in the string object
+  static size_t stringHeapBytes(const string &s) {
+    const char *data = s.data();
+    const char *self = reinterpret_cast<const char *>(&s);
+    if (data >= self && data < self + sizeof(s)) {
+      return 0;
+    }
+    return s.capacity() + 1;
+  }
+};
+
+#endif // MEMORYUSAGE_H
@@ -0,0 +1,166 @@
+/* @file neighborhood.cpp
+ * @brief The following code gives the implementations of the neighborhood
+ * analytics.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "neighborhood.h"
+#include "compactgraph.h"
+#include "intersect.h"
+#include "parallel.h"
+#include <algorithm>
+
+using namespace std;
+
+/* constructor symmetrizes the adjacency of graph, then counts the triangles
+ * through every vertex v as half the sum of |N(v) and N(u)| over u in N(v)
+ * @param graph is the graph being analyzed, threads is the thread count
+ */
+NeighborhoodAnalytics::NeighborhoodAnalytics(const Graph &graph, int threads) {
+  CompactGraph compact(graph);
+  labels = compact.labels;
+  uint32_t n = compact.verticesSize();
+
+  // counting sort of every edge in both directions
+  vector<uint64_t> count(n + 1, 0);
+  for (uint32_t v = 0; v < n; v++) {
+    for (uint64_t i = compact.offsets[v]; i < compact.offsets[v + 1]; i++) {
+      count[v + 1]++;
+      count[compact.targets[i] + 1]++;
+    }
+  }
+  for (uint32_t v = 0; v < n; v++) {
+    count[v + 1] += count[v];
+  }
+  vector<uint32_t> both(count[n]);
+  vector<uint64_t> fill(count.begin(), count.end() - 1);
+  for (uint32_t v = 0; v < n; v++) {
+    for (uint64_t i = compact.offsets[v]; i < compact.offsets[v + 1]; i++) {
+      both[fill[v]++] = compact.targets[i];
+      both[fill[compact.targets[i]]++] = v;
+    }
+  }
+
+  offsets.reserve(n + 1);
+  targets.reserve(both.size());
+  for (uint32_t v = 0; v < n; v++) {
+    offsets.push_back(targets.size());
+    auto first = both.begin() + count[v];
+    auto last = both.begin() + count[v + 1];
+    sort(first, last);
+    targets.insert(targets.end(), first, unique(first, last));
+  }
+  offsets.push_back(targets.size());
+
+  triangleCounts.assign(n, 0);
+  parallelFor(n, threads, [this](size_t begin, size_t end) {
+    for (size_t v = begin; v < end; v++) {
+      long long sum = 0;
+      const uint32_t *nv = targets.data() + offsets[v];
+      for (uint64_t i = offsets[v]; i < offsets[v + 1]; i++) {
+        uint32_t u = targets[i];
+        sum += intersect(nv, degree(v), targets.data() + offsets[u], degree(u),
+                         nullptr);
+      }
+      triangleCounts[v] = sum / 2;
+    }
+  });
+}
+
+// degree returns the undirected degree of v
+uint32_t NeighborhoodAnalytics::degree(uint32_t v) const {
+  return offsets[v + 1] - offsets[v];
+}
+
+// commonNeighbors returns the sorted labels adjacent to both a and b
+vector<string> NeighborhoodAnalytics::commonNeighbors(const string &a,
+                                                      const string &b) const {
+  vector<string> result;
+  uint32_t va = 0;
+  uint32_t vb = 0;
+  if (!labels.find(a, va) || !labels.find(b, vb)) {
+    return result;
+  }
+  vector<uint32_t> common(min(degree(va), degree(vb)));
+  size_t size = intersect(targets.data() + offsets[va], degree(va),
+                          targets.data() + offsets[vb], degree(vb),
+                          common.data());
+  // ids follow label order, so the labels come out sorted
+  for (size_t i = 0; i < size; i++) {
+    result.push_back(labels.label(common[i]));
+  }
+  return result;
+}
+
+// jaccard returns the Jaccard similarity of the neighborhoods of a and b
+double NeighborhoodAnalytics::jaccard(const string &a, const string &b) const {
+  uint32_t va = 0;
+  uint32_t vb = 0;
+  if (!labels.find(a, va) || !labels.find(b, vb)) {
+    return -1;
+  }
+  size_t common = intersect(targets.data() + offsets[va], degree(va),
+                            targets.data() + offsets[vb], degree(vb), nullptr);
+  size_t all = degree(va) + degree(vb) - common;
+  return all == 0 ? 0 : static_cast<double>(common) / all;
+}
+
+// triangles returns the number of triangles through label
+long long NeighborhoodAnalytics::triangles(const string &label) const {
+  uint32_t v = 0;
+  if (!labels.find(label, v)) {
+    return -1;
+  }
+  return triangleCounts[v];
+}
+
+// triangles returns the number of triangles in the graph
+long long NeighborhoodAnalytics::triangles() const {
+  long long sum = 0;
+  for (auto &t : triangleCounts) {
+    sum += t;
+  }
+  // every triangle is counted once at each corner
+  return sum / 3;
+}
+
+// coefficient returns triangles through v over pairs of neighbors of v
+double NeighborhoodAnalytics::coefficient(uint32_t v) const {
+  double d = degree(v);
+  if (d < 2) {
+    return 0;
+  }
+  return triangleCounts[v] / (d * (d - 1) / 2);
+}
+
+// clusteringCoefficient returns the local clustering coefficient of label
+double NeighborhoodAnalytics::clusteringCoefficient(const string &label) const {
+  uint32_t v = 0;
+  if (!labels.find(label, v)) {
+    return -1;
+  }
+  return coefficient(v);
+}
+
+// averageClustering returns the mean local clustering coefficient
+double NeighborhoodAnalytics::averageClustering() const {
+  if (triangleCounts.empty()) {
+    return 0;
+  }
+  double sum = 0;
+  for (uint32_t v = 0; v < triangleCounts.size(); v++) {
+    sum += coefficient(v);
+  }
+  return sum / triangleCounts.size();
+}
+
+// globalClustering returns the transitivity of the graph
+double NeighborhoodAnalytics::globalClustering() const {
+  double triples = 0;
+  for (uint32_t v = 0; v < triangleCounts.size(); v++) {
+    double d = degree(v);
+    triples += d * (d - 1) / 2;
+  }
+  return triples == 0 ? 0 : 3 * triangles() / triples;
+}
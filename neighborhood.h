@@ -0,0 +1,82 @@
+/* @file neighborhood.h
+ * @brief The following code gives the declarations of the neighborhood
+ * analytics: common neighbors, Jaccard similarity, triangle counts and
+ * clustering coefficients. Edge directions and weights are ignored, the
+ * analytics work on the undirected simple graph underneath graph.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#ifndef NEIGHBORHOOD_H
+#define NEIGHBORHOOD_H
+
+#include "labelpool.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class Graph;
+
+class NeighborhoodAnalytics {
+public:
+  // snapshot of graph, triangles are counted on threads threads
+  // threads <= 0 uses every hardware thread
+  explicit NeighborhoodAnalytics(const Graph &graph, int threads = 0);
+
+  // copy not allowed
+  NeighborhoodAnalytics(const NeighborhoodAnalytics &other) = delete;
+
+  // move not allowed
+  NeighborhoodAnalytics(NeighborhoodAnalytics &&other) = delete;
+
+  // assignment not allowed
+  NeighborhoodAnalytics &operator=(const NeighborhoodAnalytics &other) = delete;
+
+  // move assignment not allowed
+  NeighborhoodAnalytics &operator=(NeighborhoodAnalytics &&other) = delete;
+
+  ~NeighborhoodAnalytics() = default;
+
+  // @return sorted labels adjacent to both a and b, empty if either not found
+  vector<string> commonNeighbors(const string &a, const string &b) const;
+
+  // @return |N(a) and N(b)| / |N(a) or N(b)|, 0 if both have no neighbors,
+  // -1 if either vertex not found
+  double jaccard(const string &a, const string &b) const;
+
+  // @return number of triangles through label, -1 if vertex not found
+  long long triangles(const string &label) const;
+
+  // @return number of triangles in the graph
+  long long triangles() const;
+
+  // @return local clustering coefficient of label, 0 for degree < 2,
+  // -1 if vertex not found
+  double clusteringCoefficient(const string &label) const;
+
+  // @return mean of the local clustering coefficients
+  double averageClustering() const;
+
+  // @return 3 * triangles / connected triples of the graph
+  double globalClustering() const;
+
+private:
+  LabelPool labels;
+
+  // sorted, duplicate free undirected neighbors of v are
+  // targets[offsets[v]] .. targets[offsets[v + 1] - 1]
+  vector<uint64_t> offsets;
+
+  vector<uint32_t> targets;
+
+  // triangles through each vertex
+  vector<long long> triangleCounts;
+
+  uint32_t degree(uint32_t v) const;
+
+  double coefficient(uint32_t v) const;
+};
+
+#endif // NEIGHBORHOOD_H
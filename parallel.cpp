@@ -0,0 +1,47 @@
+/* @file parallel.cpp
+ * @brief The following code gives the implementations of the parallel loop
+ * helper.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// threadCount returns threads, or the hardware concurrency when threads <= 0
+int threadCount(int threads) {
+  if (threads > 0) {
+    return threads;
+  }
+  return max(1U, thread::hardware_concurrency());
+}
+
+/* parallelFor hands out chunks of [0, n) from a shared counter, the calling
+ * thread works too so a single thread never starts a new one
+ */
+void parallelFor(size_t n, int threads,
+                 const function<void(size_t begin, size_t end)> &body,
+                 size_t chunk) {
+  chunk = max<size_t>(chunk, 1);
+  size_t chunks = (n + chunk - 1) / chunk;
+  size_t workers = min<size_t>(threadCount(threads), chunks);
+  atomic<size_t> next(0);
+  auto work = [&]() {
+    for (size_t c = next++; c < chunks; c = next++) {
+      body(c * chunk, min(n, (c + 1) * chunk));
+    }
+  };
+  vector<thread> pool;
+  for (size_t t = 1; t < workers; t++) {
+    pool.emplace_back(work);
+  }
+  work();
+  for (auto &t : pool) {
+    t.join();
+  }
+}
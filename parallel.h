@@ -0,0 +1,25 @@
+/* @file parallel.h
+ * @brief The following code gives the declarations of the helper used by
+ * the analytics to split a loop over vertices across threads.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+using namespace std;
+
+// @return threads if positive, otherwise the number of hardware threads
+int threadCount(int threads);
+
+// call body(begin, end) for chunks of [0, n) on up to threads threads
+// chunks are handed out dynamically so uneven vertices balance out
+void parallelFor(size_t n, int threads,
+                 const function<void(size_t begin, size_t end)> &body,
+                 size_t chunk = 256);
+
+#endif // PARALLEL_H
@@ -0,0 +1,162 @@
+/* @file paths.cpp
+ * @brief The following code gives the implementations of the path queries
+ * on a CompactGraph.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "paths.h"
+#include <algorithm>
+#include <set>
+#include <utility>
+
+using namespace std;
+
+// finder for graph
+PathFinder::PathFinder(const CompactGraph &graph) : graph(graph) {}
+
+// finder for a snapshot of graph
+PathFinder::PathFinder(const Graph &graph)
+    : snapshot(new CompactGraph(graph)), graph(*snapshot) {}
+
+// edgeIndex returns the index of the edge from -> to, which must exist
+uint64_t PathFinder::edgeIndex(uint32_t from, uint32_t to) const {
+  uint64_t i = graph.offsets[from];
+  while (graph.targets[i] != to) {
+    i++;
+  }
+  return i;
+}
+
+/* shortest runs one search from from to to with the current masks
+ * @return true if to was reached, path is set to the vertices from from to to
+ */
+bool PathFinder::shortest(uint32_t from, uint32_t to, vector<uint32_t> &path) {
+  scratch.begin(graph.verticesSize(), graph.targets.size());
+  scratch.useMasks();
+  scratch.markTarget(to);
+  graph.search(from, scratch, -1);
+  path.clear();
+  if (!scratch.settled(to)) {
+    return false;
+  }
+  for (uint32_t v = to; v != from; v = scratch.prev[v]) {
+    path.push_back(v);
+  }
+  path.push_back(from);
+  reverse(path.begin(), path.end());
+  return true;
+}
+
+/* kShortestPaths is Yen's algorithm: every new path branches off a found
+ * path at a spur vertex; the root before the spur is masked out and so are
+ * the edges that found paths with the same root take next, so the spur
+ * search finds a different, loopless continuation
+ * @param from and to are the end points, k is the number of paths
+ */
+vector<Path> PathFinder::kShortestPaths(const string &from, const string &to,
+                                        int k) {
+  vector<Path> result;
+  uint32_t s = 0;
+  uint32_t t = 0;
+  if (k <= 0 || !graph.labels.find(from, s) || !graph.labels.find(to, t)) {
+    return result;
+  }
+
+  vector<vector<uint32_t>> found(1);
+  vector<int> costs;
+  if (!shortest(s, t, found[0])) {
+    return result;
+  }
+  costs.push_back(scratch.dist[t]);
+  set<vector<uint32_t>> foundSet(found.begin(), found.end());
+  set<pair<int, vector<uint32_t>>> candidates;
+  vector<uint32_t> spurPath;
+  vector<uint64_t> blockedEdges;
+
+  while (found.size() < static_cast<size_t>(k)) {
+    vector<uint32_t> last = found.back();
+    int rootCost = 0;
+    for (size_t i = 0; i + 1 < last.size(); i++) {
+      blockedEdges.clear();
+      for (auto &p : found) {
+        if (p.size() > i + 1 && equal(last.begin(), last.begin() + i + 1,
+                                      p.begin())) {
+          uint64_t e = edgeIndex(p[i], p[i + 1]);
+          if (!scratch.blockedEdge[e]) {
+            scratch.blockedEdge[e] = 1;
+            blockedEdges.push_back(e);
+          }
+        }
+      }
+      for (size_t j = 0; j < i; j++) {
+        scratch.blockedVertex[last[j]] = 1;
+      }
+
+      if (shortest(last[i], t, spurPath)) {
+        vector<uint32_t> path(last.begin(), last.begin() + i);
+        path.insert(path.end(), spurPath.begin(), spurPath.end());
+        if (foundSet.count(path) == 0) {
+          candidates.emplace(rootCost + scratch.dist[t], path);
+        }
+      }
+
+      for (size_t j = 0; j < i; j++) {
+        scratch.blockedVertex[last[j]] = 0;
+      }
+      for (auto &e : blockedEdges) {
+        scratch.blockedEdge[e] = 0;
+      }
+      rootCost += graph.weights[edgeIndex(last[i], last[i + 1])];
+    }
+
+    if (candidates.empty()) {
+      break;
+    }
+    costs.push_back(candidates.begin()->first);
+    found.push_back(candidates.begin()->second);
+    foundSet.insert(found.back());
+    candidates.erase(candidates.begin());
+  }
+
+  for (size_t i = 0; i < found.size(); i++) {
+    Path path;
+    path.cost = costs[i];
+    for (auto &v : found[i]) {
+      path.vertices.push_back(graph.labels.label(v));
+    }
+    result.push_back(path);
+  }
+  return result;
+}
+
+/* boundedSearch settles vertices in order of distance until the targets are
+ * settled or the radius is passed
+ * @param startLabel is where the search starts, targets and radius the limits
+ */
+pair<map<string, int>, map<string, string>>
+PathFinder::boundedSearch(const string &startLabel,
+                          const vector<string> &targets, int radius) {
+  map<string, int> weights;
+  map<string, string> previous;
+  uint32_t start = 0;
+  if (!graph.labels.find(startLabel, start)) {
+    return make_pair(weights, previous);
+  }
+  scratch.begin(graph.verticesSize(), graph.targets.size());
+  for (auto &label : targets) {
+    uint32_t v = 0;
+    if (graph.labels.find(label, v)) {
+      scratch.markTarget(v);
+    }
+  }
+  graph.search(start, scratch, radius);
+  for (auto &v : scratch.order) {
+    if (v != start) {
+      string name = graph.labels.label(v);
+      weights.emplace(name, scratch.dist[v]);
+      previous.emplace(name, graph.labels.label(scratch.prev[v]));
+    }
+  }
+  return make_pair(weights, previous);
+}
@@ -0,0 +1,80 @@
+/* @file paths.h
+ * @brief The following code gives the declarations of the path queries on
+ * a CompactGraph: Yen's k shortest loopless paths and a Dijkstra search
+ * bounded by a set of targets and a cost radius. A PathFinder keeps its
+ * search state between queries and hides edges with masks, the graph is
+ * never changed. Searches need dense vertex ids for their state and masks,
+ * so a finder made from a Graph takes one CompactGraph snapshot up front,
+ * not one per query. Weights must not be negative.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#ifndef PATHS_H
+#define PATHS_H
+
+#include "compactgraph.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// a path and its total weight
+struct Path {
+  int cost = 0;
+
+  // labels from the start to the end of the path
+  vector<string> vertices;
+};
+
+class PathFinder {
+public:
+  // queries on graph, which must outlive the finder
+  explicit PathFinder(const CompactGraph &graph);
+
+  // queries on one CompactGraph snapshot of graph, owned by the finder;
+  // later changes to graph are not reflected
+  explicit PathFinder(const Graph &graph);
+
+  // copy not allowed
+  PathFinder(const PathFinder &other) = delete;
+
+  // move not allowed
+  PathFinder(PathFinder &&other) = delete;
+
+  // assignment not allowed
+  PathFinder &operator=(const PathFinder &other) = delete;
+
+  // move assignment not allowed
+  PathFinder &operator=(PathFinder &&other) = delete;
+
+  ~PathFinder() = default;
+
+  // @return up to k loopless paths from from to to, cheapest first,
+  // empty if either vertex is not found or to cannot be reached
+  vector<Path> kShortestPaths(const string &from, const string &to, int k);
+
+  // dijkstra from startLabel that stops once every label in targets is
+  // settled or the next vertex costs more than radius, radius < 0 is no limit
+  // unknown targets are ignored, no known targets means no target limit
+  // @return weights and previous like Graph::dijkstra for settled vertices
+  pair<map<string, int>, map<string, string> >
+  boundedSearch(const string &startLabel, const vector<string> &targets,
+                int radius = -1);
+
+private:
+  // snapshot taken by the Graph constructor, null otherwise
+  unique_ptr<CompactGraph> snapshot;
+
+  const CompactGraph &graph;
+
+  SearchScratch scratch;
+
+  uint64_t edgeIndex(uint32_t from, uint32_t to) const;
+
+  bool shortest(uint32_t from, uint32_t to, vector<uint32_t> &path);
+};
+
+#endif // PATHS_H
@@ -0,0 +1,264 @@
+/* @file querycache.cpp
+ * @brief The following code gives the implementations of the query result
+ * cache.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "querycache.h"
+
+using namespace std;
+
+namespace {
+
+// labels visited by the bfs running on this thread
+thread_local vector<string> *bfsOrder = nullptr;
+
+void collect(const string &label) { bfsOrder->push_back(label); }
+
+// estimated bytes of a map or set node besides its value
+const size_t kNodeBytes = 4 * sizeof(void *) + MemoryUsage::kAllocOverhead;
+
+} // namespace
+
+// cache for graph
+QueryCache::QueryCache(Graph &graph, size_t maxBytes)
+    : graph(graph), maxBytes(maxBytes), version(graph.version()) {}
+
+/* dijkstra returns the cached result for startLabel, a miss runs
+ * Graph::dijkstra while holding computeLock and caches the result
+ * @param startLabel is where the search starts
+ */
+shared_ptr<const ShortestPaths> QueryCache::dijkstra(const string &startLabel) {
+  {
+    lock_guard<mutex> guard(lock);
+    Entry *entry = lookup(kDijkstra, startLabel);
+    if (entry != nullptr) {
+      counters.hits++;
+      return entry->paths;
+    }
+  }
+  lock_guard<mutex> compute(computeLock);
+  {
+    // another thread may have computed it while this one waited
+    lock_guard<mutex> guard(lock);
+    Entry *entry = lookup(kDijkstra, startLabel);
+    if (entry != nullptr) {
+      counters.hits++;
+      return entry->paths;
+    }
+    counters.misses++;
+  }
+  unsigned long computedAt = graph.version();
+  Entry entry;
+  entry.kind = kDijkstra;
+  entry.source = startLabel;
+  entry.paths = make_shared<const ShortestPaths>(graph.dijkstra(startLabel));
+  shared_ptr<const ShortestPaths> result = entry.paths;
+  lock_guard<mutex> guard(lock);
+  insert(entry, computedAt);
+  return result;
+}
+
+/* bfs returns the cached visit order for startLabel, a miss runs Graph::bfs
+ * while holding computeLock and caches the order
+ * @param startLabel is where the traversal starts
+ */
+shared_ptr<const vector<string> > QueryCache::bfs(const string &startLabel) {
+  {
+    lock_guard<mutex> guard(lock);
+    Entry *entry = lookup(kBfs, startLabel);
+    if (entry != nullptr) {
+      counters.hits++;
+      return entry->order;
+    }
+  }
+  lock_guard<mutex> compute(computeLock);
+  {
+    lock_guard<mutex> guard(lock);
+    Entry *entry = lookup(kBfs, startLabel);
+    if (entry != nullptr) {
+      counters.hits++;
+      return entry->order;
+    }
+    counters.misses++;
+  }
+  unsigned long computedAt = graph.version();
+  auto order = make_shared<vector<string> >();
+  bfsOrder = order.get();
+  graph.bfs(startLabel, collect);
+  bfsOrder = nullptr;
+  Entry entry;
+  entry.kind = kBfs;
+  entry.source = startLabel;
+  entry.order = order;
+  lock_guard<mutex> guard(lock);
+  insert(entry, computedAt);
+  return order;
+}
+
+// invalidate drops every result whose search reached label
+void QueryCache::invalidate(const string &label) {
+  lock_guard<mutex> guard(lock);
+  sync();
+  dropReaching(vector<string>(1, label));
+}
+
+// clear drops every result
+void QueryCache::clear() {
+  lock_guard<mutex> guard(lock);
+  counters.invalidations += lru.size();
+  lru.clear();
+  entries.clear();
+  counters.bytes = 0;
+  counters.entries = 0;
+  version = graph.version();
+}
+
+// stats returns a snapshot of the counters
+CacheStats QueryCache::stats() const {
+  lock_guard<mutex> guard(lock);
+  return counters;
+}
+
+// resetStats zeroes the event counters, entries and bytes stay as they are
+void QueryCache::resetStats() {
+  lock_guard<mutex> guard(lock);
+  counters.hits = 0;
+  counters.misses = 0;
+  counters.evictions = 0;
+  counters.invalidations = 0;
+}
+
+/* lookup finds a valid result and marks it most recently used, lock must be
+ * held
+ * @return the entry, nullptr if not cached
+ */
+QueryCache::Entry *QueryCache::lookup(Kind kind, const string &source) {
+  sync();
+  auto it = entries.find(make_pair(static_cast<int>(kind), source));
+  if (it == entries.end()) {
+    return nullptr;
+  }
+  lru.splice(lru.begin(), lru, it->second);
+  return &*it->second;
+}
+
+/* insert adds entry as most recently used and evicts the least recently
+ * used results until the cache fits in maxBytes, lock must be held
+ * @param computedAt is the graph version the result was computed at
+ */
+void QueryCache::insert(Entry &entry, unsigned long computedAt) {
+  sync();
+  entry.bytes = resultBytes(entry);
+  auto key = make_pair(static_cast<int>(entry.kind), entry.source);
+  // a result bigger than the whole budget is returned but not kept
+  if (computedAt != version || entry.bytes > maxBytes ||
+      entries.count(key) > 0) {
+    return;
+  }
+  lru.push_front(entry);
+  entries.emplace(key, lru.begin());
+  counters.bytes += entry.bytes;
+  counters.entries++;
+  while (counters.bytes > maxBytes) {
+    erase(--lru.end());
+    counters.evictions++;
+  }
+}
+
+/* sync brings the results up to the graph version: results that reached a
+ * changed vertex are dropped, all of them if the changes are not known
+ */
+void QueryCache::sync() {
+  unsigned long current = graph.version();
+  if (current == version) {
+    return;
+  }
+  vector<string> changed;
+  if (graph.changedSince(version, changed)) {
+    dropReaching(changed);
+  } else {
+    counters.invalidations += lru.size();
+    lru.clear();
+    entries.clear();
+    counters.bytes = 0;
+    counters.entries = 0;
+  }
+  version = current;
+}
+
+// dropReaching erases the results that reached any vertex in labels
+void QueryCache::dropReaching(const vector<string> &labels) {
+  if (labels.empty() || lru.empty()) {
+    return;
+  }
+  unordered_set<string> changed(labels.begin(), labels.end());
+  for (auto it = lru.begin(); it != lru.end();) {
+    auto next = it;
+    ++next;
+    if (reachedAny(*it, changed)) {
+      erase(it);
+      counters.invalidations++;
+    }
+    it = next;
+  }
+}
+
+// erase removes the result at it from the list, the index and the counters
+void QueryCache::erase(EntryIterator it) {
+  counters.bytes -= it->bytes;
+  counters.entries--;
+  entries.erase(make_pair(static_cast<int>(it->kind), it->source));
+  lru.erase(it);
+}
+
+/* reachedAny checks if the search behind entry reached one of labels, only
+ * a change to the edges of a reached vertex can change the result
+ */
+bool QueryCache::reachedAny(const Entry &entry,
+                            const unordered_set<string> &labels) {
+  if (labels.count(entry.source) > 0) {
+    return true;
+  }
+  if (entry.kind == kBfs) {
+    for (auto &label : *entry.order) {
+      if (labels.count(label) > 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+  for (auto &label : labels) {
+    if (entry.paths->first.count(label) > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* resultBytes estimates the heap bytes held by entry: the result, the list
+ * node and the index node with its copy of the source label
+ */
+size_t QueryCache::resultBytes(const Entry &entry) {
+  size_t bytes = sizeof(Entry) + kNodeBytes +
+                 sizeof(pair<pair<int, string>, EntryIterator>) + kNodeBytes +
+                 2 * MemoryUsage::stringHeapBytes(entry.source);
+  if (entry.kind == kBfs) {
+    bytes += sizeof(vector<string>) + MemoryUsage::kAllocOverhead +
+             entry.order->capacity() * sizeof(string);
+    for (auto &label : *entry.order) {
+      bytes += MemoryUsage::stringHeapBytes(label);
+    }
+    return bytes;
+  }
+  bytes += sizeof(ShortestPaths) + MemoryUsage::kAllocOverhead;
+  for (auto &w : entry.paths->first) {
+    bytes += kNodeBytes + sizeof(w) + MemoryUsage::stringHeapBytes(w.first);
+  }
+  for (auto &p : entry.paths->second) {
+    bytes += kNodeBytes + sizeof(p) + MemoryUsage::stringHeapBytes(p.first) +
+             MemoryUsage::stringHeapBytes(p.second);
+  }
+  return bytes;
+}
@@ -0,0 +1,146 @@
+/* @file querycache.h
+ * @brief The following code gives the declarations of the query result
+ * cache, an LRU cache of Graph::dijkstra and Graph::bfs results keyed by the
+ * start vertex. Results are checked against Graph::version on every lookup:
+ * a change to the graph drops only the results whose search reached the
+ * changed vertex, and everything if the graph no longer remembers which
+ * vertices changed. Lookups may run on many threads at once, misses are
+ * computed one at a time because Graph searches mark vertices as visited.
+ * The graph must not be changed while a cache call is running.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#ifndef QUERYCACHE_H
+#define QUERYCACHE_H
+
+#include "graph.h"
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// weights and previous, as returned by Graph::dijkstra
+typedef pair<map<string, int>, map<string, string> > ShortestPaths;
+
+// counters of a QueryCache
+struct CacheStats {
+  // lookups answered from the cache
+  long long hits = 0;
+
+  // lookups that ran a search on the graph
+  long long misses = 0;
+
+  // results dropped to stay within the byte budget
+  long long evictions = 0;
+
+  // results dropped because the graph changed or invalidate was called
+  long long invalidations = 0;
+
+  // results held and their estimated heap bytes
+  size_t entries = 0;
+
+  size_t bytes = 0;
+};
+
+class QueryCache {
+public:
+  // caches queries on graph, which must outlive the cache, keeping at most
+  // maxBytes of results
+  explicit QueryCache(Graph &graph, size_t maxBytes = 64 << 20);
+
+  // copy not allowed
+  QueryCache(const QueryCache &other) = delete;
+
+  // move not allowed
+  QueryCache(QueryCache &&other) = delete;
+
+  // assignment not allowed
+  QueryCache &operator=(const QueryCache &other) = delete;
+
+  // move assignment not allowed
+  QueryCache &operator=(QueryCache &&other) = delete;
+
+  ~QueryCache() = default;
+
+  // @return the same result as graph.dijkstra(startLabel), shared and valid
+  // after it is dropped from the cache
+  shared_ptr<const ShortestPaths> dijkstra(const string &startLabel);
+
+  // @return labels in the order graph.bfs(startLabel, visit) visits them
+  shared_ptr<const vector<string> > bfs(const string &startLabel);
+
+  // drop every result whose search reached label, for changes made to the
+  // graph's vertices some other way
+  void invalidate(const string &label);
+
+  // drop every result
+  void clear();
+
+  // @return snapshot of the counters
+  CacheStats stats() const;
+
+  // set hits, misses, evictions and invalidations back to zero
+  void resetStats();
+
+private:
+  enum Kind { kDijkstra, kBfs };
+
+  struct Entry {
+    Kind kind;
+
+    string source;
+
+    // exactly one of paths and order is set, depending on kind
+    shared_ptr<const ShortestPaths> paths;
+
+    shared_ptr<const vector<string> > order;
+
+    size_t bytes = 0;
+  };
+
+  typedef list<Entry>::iterator EntryIterator;
+
+  Graph &graph;
+
+  size_t maxBytes;
+
+  // results, most recently used first
+  list<Entry> lru;
+
+  map<pair<int, string>, EntryIterator> entries;
+
+  // graph version the results are valid for
+  unsigned long version;
+
+  CacheStats counters;
+
+  // guards every member above
+  mutable mutex lock;
+
+  // held while a miss runs a search on the graph
+  mutex computeLock;
+
+  Entry *lookup(Kind kind, const string &source);
+
+  void insert(Entry &entry, unsigned long computedAt);
+
+  void sync();
+
+  void dropReaching(const vector<string> &labels);
+
+  void erase(EntryIterator it);
+
+  static bool reachedAny(const Entry &entry,
+                         const unordered_set<string> &labels);
+
+  static size_t resultBytes(const Entry &entry);
+};
+
+#endif // QUERYCACHE_H
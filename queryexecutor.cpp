@@ -0,0 +1,313 @@
+/* @file queryexecutor.cpp
+ * @brief The following code gives the implementations of the batched query
+ * executor.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#include "queryexecutor.h"
+#include "graph.h"
+#include "parallel.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+
+namespace {
+
+// id of a query whose vertex is not in the graph
+const uint32_t kMissing = UINT32_MAX;
+
+// tasks per worker a batch is cut into, more tasks balance better
+const size_t kTasksPerWorker = 4;
+
+// most queries in one task, so a big batch still spreads out early
+const size_t kMaxTaskQueries = 64;
+
+} // namespace
+
+// a submitted batch, shared by its tasks
+struct QueryExecutor::Batch {
+  vector<Query> queries;
+
+  // vertex id of each query, kMissing if not found
+  vector<uint32_t> ids;
+
+  // query indices by kind, then id, then label, so repeats are adjacent
+  vector<size_t> sorted;
+
+  vector<QueryResult> results;
+
+  atomic<size_t> tasksLeft;
+
+  chrono::steady_clock::time_point start;
+
+  // called with the results if set, otherwise ready is fulfilled
+  function<void(vector<QueryResult> &results)> done;
+
+  promise<vector<QueryResult> > ready;
+
+  // @return true if queries i and j of sorted ask the same thing
+  bool same(size_t i, size_t j) const {
+    const Query &a = queries[sorted[i]];
+    const Query &b = queries[sorted[j]];
+    return a.kind == b.kind && a.label == b.label;
+  }
+};
+
+/* constructor takes the snapshot in breadth-first order, so sources that
+ * are close in the graph get nearby ids, and starts the workers
+ * @param graph is the graph being queried, threads the number of workers
+ */
+QueryExecutor::QueryExecutor(const Graph &graph, int threads)
+    : graph(graph), queued(0), nextWorker(0), batches(0), queries(0),
+      computed(0), steals(0) {
+  this->graph.reorder(kOrderBfs);
+  int count = threadCount(threads);
+  for (int t = 0; t < count; t++) {
+    workers.emplace_back(new Worker());
+  }
+  for (int t = 0; t < count; t++) {
+    pool.emplace_back(&QueryExecutor::work, this, t);
+  }
+}
+
+// destructor lets the workers drain their queues and joins them
+QueryExecutor::~QueryExecutor() {
+  {
+    lock_guard<mutex> guard(lock);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (auto &t : pool) {
+    t.join();
+  }
+}
+
+// submit queues batch and returns a future for its results
+future<vector<QueryResult> >
+QueryExecutor::submit(const vector<Query> &batch) {
+  shared_ptr<Batch> prepared = prepare(batch);
+  future<vector<QueryResult> > results = prepared->ready.get_future();
+  if (batch.empty()) {
+    prepared->ready.set_value(vector<QueryResult>());
+  } else {
+    enqueue(prepared);
+  }
+  return results;
+}
+
+// submit queues batch and calls done with its results
+void QueryExecutor::submit(
+    const vector<Query> &batch,
+    const function<void(vector<QueryResult> &results)> &done) {
+  shared_ptr<Batch> prepared = prepare(batch);
+  prepared->done = done;
+  if (batch.empty()) {
+    done(prepared->results);
+  } else {
+    enqueue(prepared);
+  }
+}
+
+// threads returns the number of workers
+int QueryExecutor::threads() const { return static_cast<int>(workers.size()); }
+
+// stats returns a snapshot of the counters
+ExecutorStats QueryExecutor::stats() const {
+  ExecutorStats s;
+  s.batches = batches;
+  s.queries = queries;
+  s.computed = computed;
+  s.steals = steals;
+  return s;
+}
+
+/* prepare looks up the vertex of every query and sorts the queries so
+ * neighboring vertices, which have nearby ids, run one after another
+ * @param batch is the queries as submitted
+ */
+shared_ptr<QueryExecutor::Batch>
+QueryExecutor::prepare(const vector<Query> &batch) {
+  auto prepared = make_shared<Batch>();
+  prepared->start = chrono::steady_clock::now();
+  prepared->queries = batch;
+  prepared->results.resize(batch.size());
+  prepared->ids.resize(batch.size());
+  prepared->sorted.resize(batch.size());
+  for (size_t i = 0; i < batch.size(); i++) {
+    uint32_t id = 0;
+    prepared->ids[i] = graph.labels.find(batch[i].label, id) ? id : kMissing;
+    prepared->sorted[i] = i;
+  }
+  const Batch &b = *prepared;
+  sort(prepared->sorted.begin(), prepared->sorted.end(),
+       [&b](size_t i, size_t j) {
+         if (b.queries[i].kind != b.queries[j].kind) {
+           return b.queries[i].kind < b.queries[j].kind;
+         }
+         if (b.ids[i] != b.ids[j]) {
+           return b.ids[i] < b.ids[j];
+         }
+         return b.queries[i].label < b.queries[j].label;
+       });
+  batches++;
+  queries += batch.size();
+  return prepared;
+}
+
+/* enqueue cuts the sorted batch into tasks, never splitting repeats of one
+ * query, and gives each worker a run of consecutive tasks
+ * @param batch is a prepared, non-empty batch
+ */
+void QueryExecutor::enqueue(const shared_ptr<Batch> &batch) {
+  size_t n = batch->sorted.size();
+  size_t perTask = n / (workers.size() * kTasksPerWorker);
+  perTask = min(max<size_t>(perTask, 1), kMaxTaskQueries);
+  vector<Task> tasks;
+  for (size_t begin = 0; begin < n;) {
+    size_t end = min(n, begin + perTask);
+    while (end < n && batch->same(end - 1, end)) {
+      end++;
+    }
+    Task task;
+    task.batch = batch;
+    task.begin = begin;
+    task.end = end;
+    tasks.push_back(task);
+    begin = end;
+  }
+  batch->tasksLeft = tasks.size();
+
+  size_t w = workers.size();
+  size_t first = nextWorker++;
+  for (size_t t = 0; t < tasks.size(); t++) {
+    Worker &worker = *workers[(first + t * w / tasks.size()) % w];
+    lock_guard<mutex> guard(worker.lock);
+    worker.tasks.push_back(tasks[t]);
+  }
+  queued += tasks.size();
+  {
+    // a worker deciding to sleep holds lock, so it sees queued or the notify
+    lock_guard<mutex> guard(lock);
+  }
+  wake.notify_all();
+}
+
+/* take gets the next task of worker self, or steals the last task of
+ * another worker, which is the one furthest from what that worker runs next
+ * @return false if every queue is empty
+ */
+bool QueryExecutor::take(size_t self, Task &task) {
+  size_t w = workers.size();
+  for (size_t i = 0; i < w; i++) {
+    Worker &victim = *workers[(self + i) % w];
+    lock_guard<mutex> guard(victim.lock);
+    if (victim.tasks.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      task = victim.tasks.front();
+      victim.tasks.pop_front();
+    } else {
+      task = victim.tasks.back();
+      victim.tasks.pop_back();
+      steals++;
+    }
+    queued--;
+    return true;
+  }
+  return false;
+}
+
+// work runs tasks until the executor stops and no task is left
+void QueryExecutor::work(size_t self) {
+  Worker &worker = *workers[self];
+  Task task;
+  while (true) {
+    if (take(self, task)) {
+      run(task, worker);
+      task.batch.reset();
+      continue;
+    }
+    unique_lock<mutex> guard(lock);
+    if (queued > 0) {
+      continue;
+    }
+    if (stopping) {
+      return;
+    }
+    wake.wait(guard, [this]() { return stopping || queued > 0; });
+  }
+}
+
+/* run answers the queries of task, copying the answer of a repeat, and
+ * completes the batch after its last task
+ * @param task is the range to run, worker has the scratch to use
+ */
+void QueryExecutor::run(Task &task, Worker &worker) {
+  Batch &batch = *task.batch;
+  for (size_t i = task.begin; i < task.end; i++) {
+    size_t q = batch.sorted[i];
+    QueryResult &result = batch.results[q];
+    if (i > task.begin && batch.same(i - 1, i)) {
+      result = batch.results[batch.sorted[i - 1]];
+    } else {
+      answer(batch.queries[q], batch.ids[q], worker, result);
+      computed++;
+    }
+    result.latency = chrono::duration<double>(chrono::steady_clock::now() -
+                                              batch.start)
+                         .count();
+  }
+  if (--batch.tasksLeft > 0) {
+    return;
+  }
+  if (batch.done) {
+    batch.done(batch.results);
+  } else {
+    batch.ready.set_value(move(batch.results));
+  }
+}
+
+/* answer runs one query with the scratch of worker, so no O(V) array is
+ * allocated or cleared per query
+ * @param query is the query, id its vertex, result receives the answer
+ */
+void QueryExecutor::answer(const Query &query, uint32_t id, Worker &worker,
+                           QueryResult &result) {
+  if (id == kMissing) {
+    return;
+  }
+  if (query.kind == kQueryEdges) {
+    result.edges = graph.getEdgesAsString(query.label);
+    return;
+  }
+
+  SearchScratch &scratch = worker.scratch;
+  if (query.kind == kQueryDijkstra) {
+    result.paths = graph.dijkstra(query.label, scratch);
+    return;
+  }
+
+  // scratch.order is the bfs queue, seen marks queued vertices
+  scratch.begin(graph.verticesSize(), graph.targets.size());
+  auto &q = scratch.order;
+  q.clear();
+  scratch.seen[id] = scratch.generation;
+  q.push_back(id);
+  for (size_t head = 0; head < q.size(); head++) {
+    uint32_t v = q[head];
+    for (uint64_t i = graph.offsets[v]; i < graph.offsets[v + 1]; i++) {
+      uint32_t n = graph.targets[i];
+      if (scratch.seen[n] != scratch.generation) {
+        scratch.seen[n] = scratch.generation;
+        q.push_back(n);
+      }
+    }
+  }
+  result.order.reserve(q.size());
+  for (auto &v : q) {
+    result.order.push_back(graph.labels.label(v));
+  }
+}
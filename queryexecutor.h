@@ -0,0 +1,179 @@
+/* @file queryexecutor.h
+ * @brief The following code gives the declarations of the batched query
+ * executor. It answers dijkstra, bfs and getEdgesAsString queries on a
+ * snapshot of a Graph with a pool of worker threads. The snapshot is
+ * numbered in breadth-first order and each batch is sorted by query kind
+ * and vertex id, so repeated queries are answered once and sources close
+ * in the graph are handed out together to one worker. Every worker has its own
+ * task queue and search scratch; idle workers steal from the others.
+ * Graph itself stays the way to run a single query.
+ * @author Anthony Vu
+ * @date 10/19/2026
+ */
+
+#ifndef QUERYEXECUTOR_H
+#define QUERYEXECUTOR_H
+
+#include "compactgraph.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+class Graph;
+
+// queries a QueryExecutor can answer
+enum QueryKind {
+  // weights of Graph::dijkstra, previous may name another vertex where two
+  // paths tie
+  kQueryDijkstra,
+  // labels in the order Graph::bfs visits them
+  kQueryBfs,
+  // Graph::getEdgesAsString
+  kQueryEdges
+};
+
+struct Query {
+  QueryKind kind = kQueryDijkstra;
+
+  // start vertex, or the vertex whose edges are listed
+  string label;
+};
+
+// answer to one Query, only the field for its kind is filled in
+struct QueryResult {
+  // weights and previous for kQueryDijkstra
+  pair<map<string, int>, map<string, string> > paths;
+
+  // visit order for kQueryBfs
+  vector<string> order;
+
+  // edges for kQueryEdges
+  string edges;
+
+  // seconds from submitting the batch until this result was ready
+  double latency = 0;
+};
+
+// counters of a QueryExecutor
+struct ExecutorStats {
+  long long batches = 0;
+
+  long long queries = 0;
+
+  // queries that ran a search, repeats within a batch are copied instead
+  long long computed = 0;
+
+  // tasks a worker took from another worker's queue
+  long long steals = 0;
+};
+
+class QueryExecutor {
+public:
+  // snapshot of graph answered by threads workers, threads <= 0 uses the
+  // number of hardware threads; later changes to graph are not reflected
+  explicit QueryExecutor(const Graph &graph, int threads = 0);
+
+  // copy not allowed
+  QueryExecutor(const QueryExecutor &other) = delete;
+
+  // move not allowed
+  QueryExecutor(QueryExecutor &&other) = delete;
+
+  // assignment not allowed
+  QueryExecutor &operator=(const QueryExecutor &other) = delete;
+
+  // move assignment not allowed
+  QueryExecutor &operator=(QueryExecutor &&other) = delete;
+
+  // finish every submitted batch, then stop the workers
+  ~QueryExecutor();
+
+  // queue batch, results are in the same order as the queries
+  // @return future that becomes ready when the whole batch is answered
+  future<vector<QueryResult> > submit(const vector<Query> &batch);
+
+  // queue batch and call done with the results on a worker thread once the
+  // whole batch is answered, or right away if batch is empty
+  void submit(const vector<Query> &batch,
+              const function<void(vector<QueryResult> &results)> &done);
+
+  // @return number of worker threads
+  int threads() const;
+
+  // @return snapshot of the counters
+  ExecutorStats stats() const;
+
+private:
+  struct Batch;
+
+  // sorted[begin] .. sorted[end - 1] of batch, run by one worker
+  struct Task {
+    shared_ptr<Batch> batch;
+
+    size_t begin = 0;
+
+    size_t end = 0;
+  };
+
+  struct Worker {
+    // guards tasks, the owner takes from the front, thieves from the back
+    mutex lock;
+
+    deque<Task> tasks;
+
+    SearchScratch scratch;
+  };
+
+  CompactGraph graph;
+
+  vector<unique_ptr<Worker> > workers;
+
+  vector<thread> pool;
+
+  // guards stopping and is held to wait for work
+  mutex lock;
+
+  condition_variable wake;
+
+  bool stopping = false;
+
+  // tasks pushed and not taken yet, briefly negative while a batch is queued
+  atomic<long long> queued;
+
+  // worker that gets the first task of the next batch
+  atomic<size_t> nextWorker;
+
+  atomic<long long> batches;
+
+  atomic<long long> queries;
+
+  atomic<long long> computed;
+
+  atomic<long long> steals;
+
+  shared_ptr<Batch> prepare(const vector<Query> &batch);
+
+  void enqueue(const shared_ptr<Batch> &batch);
+
+  bool take(size_t self, Task &task);
+
+  void work(size_t self);
+
+  void run(Task &task, Worker &worker);
+
+  void answer(const Query &query, uint32_t id, Worker &worker,
+              QueryResult &result);
+};
+
+#endif // QUERYEXECUTOR_H
@@ -17,6 +17,7 @@ using namespace std;
 class Vertex {
   friend class Graph;
   friend class Edge;
+  friend class CompactGraph;
 
   string label;
   bool visited;